@@ -0,0 +1,223 @@
+/***********************************************************************
+ * Header:
+ *    BUFFER POOL
+ * Summary:
+ *    A cache of freed arrays so that short-lived deques stop going
+ *    to malloc every time they grow. Hand a deque a pool_allocator:
+ *
+ *        custom::deque<int, custom::capacity_any,
+ *                      custom::pool_allocator<int>> d;
+ *
+ *    With capacity_usable the deque also keeps the slack at the end
+ *    of each size class instead of leaving it unused.
+ *
+ *    This will contain the class definition of:
+ *        buffer_pool           : freed arrays, by power-of-two size class
+ *        pool_allocator        : an allocator that draws from a buffer_pool
+ * Author
+ *    Alexander Dohms, Stephen Costigan, Shaun Crook, Jonathan Colwell
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>       // for size_t
+#include <new>           // for ::operator new, std::bad_alloc
+#include <type_traits>   // for std::true_type
+
+namespace custom
+{
+
+/******************************************************
+ * BUFFER POOL
+ * Every request is rounded up to a power of two and a
+ * freed array goes onto the free list of its size class,
+ * up to numPerClass arrays per class. The deque grows
+ * 1, 2, 4, 8 ... so a new deque walking up the same sizes
+ * finds each array waiting for it.
+ *
+ *    class  4 (16 bytes) : [ ] -> [ ]
+ *    class  5 (32 bytes) :
+ *    class  6 (64 bytes) : [ ]
+ *
+ * A pool is not thread-safe. buffer_pool::local() gives
+ * each thread its own.
+ *****************************************************/
+class buffer_pool
+{
+public:
+   explicit buffer_pool(size_t numPerClass = 8)
+      : numPerClass(numPerClass), numHits(0), numMisses(0)
+   {
+      for (int i = 0; i < numClasses; i++)
+      {
+         freeList[i] = nullptr;
+         numFree[i] = 0;
+      }
+   }
+   buffer_pool(const buffer_pool &) = delete;
+   buffer_pool & operator = (const buffer_pool &) = delete;
+   ~buffer_pool() { trim(); }
+
+   // the pool of the calling thread
+   static buffer_pool & local()
+   {
+      static thread_local buffer_pool pool;
+      return pool;
+   }
+
+   //
+   // Acquire and release
+   //
+   void * acquire(size_t numBytes)
+   {
+      int iClass = sizeClass(numBytes);
+      if (freeList[iClass])
+      {
+         Node * pNode = freeList[iClass];
+         freeList[iClass] = pNode->pNext;
+         numFree[iClass]--;
+         numHits++;
+         return pNode;
+      }
+      numMisses++;
+      return ::operator new((size_t)1 << iClass);
+   }
+   void release(void * p, size_t numBytes)
+   {
+      int iClass = sizeClass(numBytes);
+      if (numFree[iClass] < numPerClass)
+      {
+         Node * pNode = static_cast<Node *>(p);
+         pNode->pNext = freeList[iClass];
+         freeList[iClass] = pNode;
+         numFree[iClass]++;
+      }
+      else
+         ::operator delete(p);
+   }
+
+   // give every cached array back to the system
+   void trim()
+   {
+      for (int i = 0; i < numClasses; i++)
+      {
+         while (freeList[i])
+         {
+            Node * pNode = freeList[i];
+            freeList[i] = pNode->pNext;
+            ::operator delete(pNode);
+         }
+         numFree[i] = 0;
+      }
+   }
+
+   //
+   // Statistics
+   //
+   size_t hits()   const { return numHits;   }
+   size_t misses() const { return numMisses; }
+   size_t cached() const
+   {
+      size_t num = 0;
+      for (int i = 0; i < numClasses; i++)
+         num += numFree[i];
+      return num;
+   }
+   void reset_counters() { numHits = numMisses = 0; }
+
+   // the number of bytes really handed out for a request of numBytes
+   static size_t usable(size_t numBytes)
+   {
+      return (size_t)1 << sizeClass(numBytes);
+   }
+
+#ifdef DEBUG // make this visible to the unit tests
+public:
+#else
+private:
+#endif
+
+   // a cached array holds the link to the next one
+   struct Node
+   {
+      Node * pNext;
+   };
+
+   // smallest class k with 2^k >= numBytes, at least big enough for a Node
+   static int sizeClass(size_t numBytes)
+   {
+      int iClass = minClass;
+      while (((size_t)1 << iClass) < numBytes)
+      {
+         if (++iClass == numClasses)
+            throw std::bad_alloc();
+      }
+      return iClass;
+   }
+
+   static const int minClass   = 4;                    // 16 bytes
+   static const int numClasses = sizeof(size_t) * 8;   // one per bit
+
+   Node * freeList[numClasses];  // cached arrays, one list per size class
+   size_t numFree[numClasses];   // length of each list
+   size_t numPerClass;           // the most arrays kept in one class
+   size_t numHits;               // requests served from a list
+   size_t numMisses;             // requests that went to the system
+};
+
+/******************************************************
+ * POOL ALLOCATOR
+ * Draws arrays from a buffer_pool. By default that is the
+ * pool of whichever thread is allocating or freeing, so an
+ * array freed on another thread simply joins that thread's
+ * pool.
+ *****************************************************/
+template <class T>
+class pool_allocator
+{
+public:
+   typedef T value_type;
+   typedef std::true_type propagate_on_container_move_assignment;
+   typedef std::true_type propagate_on_container_swap;
+
+   pool_allocator() noexcept : pPool(nullptr) { }
+   explicit pool_allocator(buffer_pool & pool) noexcept : pPool(&pool) { }
+   template <class U>
+   pool_allocator(const pool_allocator<U> & rhs) noexcept : pPool(rhs.pPool) { }
+
+   T * allocate(size_t num)
+   {
+      if (num > (size_t)-1 / sizeof(T))
+         throw std::bad_alloc();
+      return static_cast<T *>(pool().acquire(num * sizeof(T)));
+   }
+   // the whole size class is ours, so report every slot in it
+   struct allocation_result
+   {
+      T * ptr;
+      size_t count;
+   };
+   allocation_result allocate_at_least(size_t num)
+   {
+      T * p = allocate(num);
+      return { p, buffer_pool::usable(num * sizeof(T)) / sizeof(T) };
+   }
+   void deallocate(T * p, size_t num)
+   {
+      pool().release(p, num * sizeof(T));
+   }
+
+   buffer_pool & pool() const
+   {
+      return pPool ? *pPool : buffer_pool::local();
+   }
+
+   template <class U>
+   bool operator == (const pool_allocator<U> & rhs) const { return pPool == rhs.pPool; }
+   template <class U>
+   bool operator != (const pool_allocator<U> & rhs) const { return pPool != rhs.pPool; }
+
+   buffer_pool * pPool;   // nullptr for the pool of the calling thread
+};
+
+} // namespace custom
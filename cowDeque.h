@@ -0,0 +1,223 @@
+/***********************************************************************
+ * Header:
+ *    COW DEQUE
+ * Summary:
+ *    A deque whose copies share one buffer until one of them changes,
+ *    so a snapshot costs a reference count instead of a copy:
+ *
+ *        custom::cow_deque<int> live;
+ *        ...
+ *        custom::cow_deque<int> snapshot(live);   // O(1)
+ *        live.push_back(99);                      // live copies, once
+ *
+ *    This will contain the class definition of:
+ *        cow_deque             : copy-on-write wrapper around deque
+ * Author
+ *    Alexander Dohms, Stephen Costigan, Shaun Crook, Jonathan Colwell
+ ************************************************************************/
+
+#pragma once
+
+#include "deque.h"   // for custom::deque
+#include <atomic>    // for std::atomic_thread_fence
+#include <cassert>
+#include <memory>    // for std::shared_ptr
+
+namespace custom
+{
+
+/******************************************************
+ * COW DEQUE
+ * Holds a reference-counted deque. Reading never copies.
+ * Anything that may change the elements, including the
+ * non-const access methods and begin(), first makes the
+ * deque its own if anyone else still shares it:
+ *
+ *    live ------+                live -----> [ 1 2 3 99 ]
+ *               +--> [ 1 2 3 ]
+ *    snapshot --+                snapshot -> [ 1 2 3 ]
+ *
+ * A snapshot may be read on another thread while the
+ * original goes on changing. One cow_deque is no more
+ * thread-safe than a deque.
+ *
+ * A reference or iterator handed out by a non-const
+ * method could write into a buffer shared by a later
+ * copy. So once one is handed out, the deque is
+ * unshareable: copies of it copy the elements at once,
+ * until clear() or assignment gives it a new buffer.
+ *
+ * An empty cow_deque, including a moved-from one, holds
+ * no deque at all.
+ *****************************************************/
+template <class T, class Capacity = capacity_any, class Allocator = std::allocator<T>>
+class cow_deque
+{
+public:
+   typedef custom::deque<T, Capacity, Allocator> deque_type;
+   typedef typename deque_type::iterator iterator;
+   typedef std::allocator_traits<Allocator> alloc_traits;
+
+   //
+   // Construct
+   //
+
+   cow_deque() : cow_deque(Allocator()) { }
+   explicit cow_deque(const Allocator & alloc) : alloc(alloc), unshareable(false) { }
+   cow_deque(const cow_deque & rhs)
+      : pDeque(rhs.share()),
+        alloc(alloc_traits::select_on_container_copy_construction(rhs.alloc)),
+        unshareable(false) { }
+   cow_deque(cow_deque && rhs) noexcept
+      : pDeque(std::move(rhs.pDeque)), alloc(rhs.alloc), unshareable(rhs.unshareable)
+   {
+      rhs.unshareable = false;
+   }
+   explicit cow_deque(const deque_type & rhs)
+      : pDeque(std::make_shared<deque_type>(rhs)), alloc(rhs.get_allocator()), unshareable(false) { }
+   explicit cow_deque(deque_type && rhs)
+      : pDeque(std::make_shared<deque_type>(std::move(rhs))), alloc(pDeque->get_allocator()),
+        unshareable(false) { }
+
+   //
+   // Assign
+   //
+   cow_deque & operator = (const cow_deque & rhs)
+   {
+      if (this != &rhs)
+      {
+         pDeque = rhs.share();
+         propagateCopy(alloc, rhs.alloc, typename alloc_traits::propagate_on_container_copy_assignment());
+         unshareable = false;
+      }
+      return *this;
+   }
+   cow_deque & operator = (cow_deque && rhs)
+      noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+               alloc_traits::is_always_equal::value)
+   {
+      if (this != &rhs)
+      {
+         pDeque = std::move(rhs.pDeque);
+         propagateMove(alloc, rhs.alloc, typename alloc_traits::propagate_on_container_move_assignment());
+         unshareable = rhs.unshareable;
+         rhs.unshareable = false;
+      }
+      return *this;
+   }
+   void swap(cow_deque & rhs) noexcept
+   {
+      std::swap(pDeque,      rhs.pDeque);
+      propagateSwap(alloc, rhs.alloc, typename alloc_traits::propagate_on_container_swap());
+      std::swap(unshareable, rhs.unshareable);
+   }
+
+   //
+   // Iterator
+   //
+   iterator begin() { return lend().begin(); }
+   iterator end()   { return lend().end();   }
+
+   //
+   // Access
+   //
+   const T & front() const { assert(pDeque); return pDeque->front(); }
+   const T & back()  const { assert(pDeque); return pDeque->back();  }
+   T & front()             { return lend().front(); }
+   T & back()              { return lend().back();  }
+
+   const T & operator[](size_t index) const { assert(pDeque); return (*pDeque)[index]; }
+         T & operator[](size_t index)       { return lend()[index];  }
+
+   //
+   // Insert
+   //
+   void push_front(const T& t) { write().push_front(t);            }
+   void push_back(const T& t)  { write().push_back(t);             }
+   void push_front(T&& t)      { write().push_front(std::move(t)); }
+   void push_back(T&& t)       { write().push_back(std::move(t));  }
+   template <class ... Args>
+   T & emplace_front(Args && ... args) { return lend().emplace_front(std::forward<Args>(args)...); }
+   template <class ... Args>
+   T & emplace_back(Args && ... args)  { return lend().emplace_back(std::forward<Args>(args)...);  }
+
+   //
+   // Remove
+   //
+   void clear()          { pDeque.reset(); unshareable = false; }   // nothing to copy
+   void pop_front()      { write().pop_front();      }
+   void pop_back()       { write().pop_back();       }
+   void pop_front(T & t) { write().pop_front(t);     }
+   void pop_back(T & t)  { write().pop_back(t);      }
+
+   //
+   // Status
+   //
+   size_t size() const { return pDeque ? pDeque->size() : 0; }
+   bool empty() const  { return size() == 0; }
+   bool shared() const { return pDeque && pDeque.use_count() > 1; }
+   Allocator get_allocator() const { return alloc; }
+
+   // the deque itself, for reading only, or nullptr while empty
+   const deque_type * get() const { return pDeque.get(); }
+
+#ifdef DEBUG // make this visible to the unit tests
+public:
+#else
+private:
+#endif
+
+   deque_type & write();
+
+   // write(), for a caller that keeps a reference into the deque
+   deque_type & lend()
+   {
+      deque_type & d = write();
+      unshareable = true;
+      return d;
+   }
+
+   // the buffer for a new copy: ours, or a copy of it if references are out
+   std::shared_ptr<deque_type> share() const
+   {
+      if (unshareable && pDeque)
+         return std::make_shared<deque_type>(*pDeque);
+      return pDeque;
+   }
+
+   // member variables
+   std::shared_ptr<deque_type> pDeque;   // shared with every copy until one writes
+   Allocator alloc;                      // for the deque when there is none yet
+   bool unshareable;                     // a reference into pDeque has been handed out
+};
+
+/****************************************************
+ * COW DEQUE : WRITE
+ * Make the deque ours alone before it changes. The
+ * fence pairs with the release in another copy's
+ * decrement, so its last reads are done before we write.
+ ***************************************************/
+template <class T, class Capacity, class Allocator>
+typename cow_deque <T, Capacity, Allocator> ::deque_type &
+cow_deque <T, Capacity, Allocator> :: write()
+{
+   if (!pDeque)
+      pDeque = std::make_shared<deque_type>(alloc);
+   else if (pDeque.use_count() > 1)
+      pDeque = std::make_shared<deque_type>(*pDeque);
+   else
+      std::atomic_thread_fence(std::memory_order_acquire);
+   return *pDeque;
+}
+
+/******************************************************
+ * SWAP : COW
+ ******************************************************/
+template <class T, class Capacity, class Allocator>
+void swap(cow_deque <T, Capacity, Allocator> & lhs,
+          cow_deque <T, Capacity, Allocator> & rhs) noexcept
+{
+   lhs.swap(rhs);
+}
+
+} // namespace custom
@@ -22,10 +22,319 @@
 // Debug stuff
 #include <cassert>
 #include <iostream>
+#include <cstddef>   // for size_t
+#include <memory>    // for std::allocator, std::allocator_traits
+#include <utility>   // for std::move, std::swap
+#include <type_traits>   // for std::true_type, std::is_trivially_copyable
+#include <cstring>   // for std::memcpy, std::memmove
+#include <limits>    // for std::numeric_limits
+#include <stdexcept> // for std::length_error
+#include <iterator>  // for std::iterator_traits, std::distance
+#include <algorithm> // for std::rotate, std::min, std::move_backward
+#include <initializer_list>
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#define DEQUE_PMR            // std::pmr arrived in C++17
+#include <memory_resource>   // for std::pmr::polymorphic_allocator
+#endif
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#include <span>              // for std::span
+#endif
+#ifdef __cpp_lib_span
+#define DEQUE_SPAN           // std::span arrived in C++20
+#endif
+
+// C++20 lets a constant expression allocate, as long as it frees
+// everything again, so the whole deque can run at compile time
+#if defined(__cpp_constexpr_dynamic_alloc) && defined(__cpp_lib_constexpr_dynamic_alloc) && \
+    defined(__cpp_lib_is_constant_evaluated)
+#define DEQUE_CONSTEXPR_ALLOC   // custom::deque works in constant expressions
+#define DEQUE_CONSTEXPR constexpr
+#else
+#define DEQUE_CONSTEXPR
+#endif
+
+// an empty allocator takes no room in the deque
+#if defined(_MSC_VER) && _MSC_VER >= 1929
+#define DEQUE_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#elif defined(__has_cpp_attribute)
+#if __has_cpp_attribute(no_unique_address)
+#define DEQUE_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+#endif
+#ifndef DEQUE_NO_UNIQUE_ADDRESS
+#define DEQUE_NO_UNIQUE_ADDRESS
+#endif
 
 namespace custom
 {
 
+/******************************************************
+ * CAPACITY POLICIES
+ * Decide how big the array becomes when the deque grows and
+ * how an array index that ran off the end is folded back
+ * to the beginning. The deque keeps 0 <= iaFront < numCapacity,
+ * so iaFront + id is always less than 2 * numCapacity and one
+ * fold is all it ever needs.
+ *
+ * round(num) is the capacity to allocate for num slots, and
+ * largest(num) the biggest capacity no more than num that
+ * round() can give back.
+ *
+ *    capacity_any          : any capacity, double, fold with a conditional subtract
+ *    capacity_pow2         : capacity is a power of two, fold with a mask
+ *    capacity_three_halves : grow by half, wasting at most a third
+ *    capacity_step<N>      : grow by N slots at a time
+ *    capacity_usable<Base> : grow as Base, then keep every slot
+ *                            the allocator really handed out
+ *    capacity_shrink<Base> : grow as Base, and halve on pop once
+ *                            the deque is only a quarter full
+ *    capacity_index<I, Base> : grow as Base, but count and index
+ *                            with the unsigned type I
+ *    capacity_mirror       : in mirrorAllocator.h, never fold at all
+ *****************************************************/
+struct capacity_any
+{
+   typedef size_t index_type;            // see capacity_index
+   static const bool mirrored = false;   // see capacity_mirror
+   static DEQUE_CONSTEXPR size_t round(size_t num) { return num; }
+   static DEQUE_CONSTEXPR size_t largest(size_t num) { return num; }
+   static DEQUE_CONSTEXPR size_t grow(size_t numCapacity)
+   {
+      return numCapacity ? numCapacity * 2 : 1;
+   }
+   static DEQUE_CONSTEXPR size_t wrap(size_t ia, size_t numCapacity)
+   {
+      return ia - (ia >= numCapacity ? numCapacity : 0);
+   }
+   static DEQUE_CONSTEXPR size_t shrink(size_t /*numElements*/, size_t numCapacity)
+   {
+      return numCapacity;
+   }
+};
+
+struct capacity_pow2
+{
+   typedef size_t index_type;
+   static const bool mirrored = false;
+   static DEQUE_CONSTEXPR size_t round(size_t num)
+   {
+      size_t numCapacity = 1;
+      while (numCapacity < num)
+         numCapacity <<= 1;
+      return num ? numCapacity : 0;
+   }
+   static DEQUE_CONSTEXPR size_t largest(size_t num)
+   {
+      size_t numCapacity = 1;
+      while (numCapacity <= num / 2)
+         numCapacity <<= 1;
+      return num ? numCapacity : 0;
+   }
+   static DEQUE_CONSTEXPR size_t grow(size_t numCapacity)
+   {
+      return numCapacity ? numCapacity * 2 : 1;
+   }
+   static DEQUE_CONSTEXPR size_t wrap(size_t ia, size_t numCapacity)
+   {
+      return ia & (numCapacity - 1);
+   }
+   static DEQUE_CONSTEXPR size_t shrink(size_t /*numElements*/, size_t numCapacity)
+   {
+      return numCapacity;
+   }
+};
+
+struct capacity_three_halves : capacity_any
+{
+   static DEQUE_CONSTEXPR size_t grow(size_t numCapacity)
+   {
+      return numCapacity < 2 ? numCapacity + 1 : numCapacity + numCapacity / 2;
+   }
+};
+
+template <size_t numStep>
+struct capacity_step : capacity_any
+{
+   static_assert(numStep > 0, "capacity_step must grow");
+   static DEQUE_CONSTEXPR size_t grow(size_t numCapacity)
+   {
+      return numCapacity + numStep;
+   }
+};
+
+// Base must fold any capacity, the allocator may return an odd count
+template <class Base = capacity_any>
+struct capacity_usable : Base
+{
+   static_assert(!std::is_base_of<capacity_pow2, Base>::value,
+                 "capacity_usable cannot mask: the allocator may hand back any count");
+};
+
+// Halving at numPercent full leaves the deque at most twice that,
+// so a push right after a shrink never has to grow it back
+template <class Base = capacity_any, size_t numPercent = 25, size_t numMinimum = 16>
+struct capacity_shrink : Base
+{
+   static_assert(numPercent < 50, "capacity_shrink would thrash at half full");
+   static DEQUE_CONSTEXPR size_t shrink(size_t numElements, size_t numCapacity)
+   {
+      if (numCapacity / 2 < numMinimum || numElements * 100 > numCapacity * numPercent)
+         return numCapacity;
+      return numCapacity / 2;
+   }
+};
+
+// A 32-bit index makes a smaller deque that holds at most 2^32 - 1 elements,
+// or 2^31 when Base must round to a power of two
+template <class Index, class Base = capacity_any>
+struct capacity_index : Base
+{
+   static_assert(std::is_unsigned<Index>::value, "capacity_index needs an unsigned type");
+   typedef Index index_type;
+};
+
+template <class Capacity>
+struct fitsAllocator : std::false_type { };
+template <class Base>
+struct fitsAllocator <capacity_usable<Base>> : std::true_type { };
+template <class Index, class Base>
+struct fitsAllocator <capacity_index<Index, Base>> : fitsAllocator<Base> { };
+template <class Base, size_t numPercent, size_t numMinimum>
+struct fitsAllocator <capacity_shrink<Base, numPercent, numMinimum>> : fitsAllocator<Base> { };
+
+/******************************************************
+ * SHRINK FLOOR
+ * The smallest shrink an allocator that rounds up has
+ * already handed back at full size, so autoShrink() does
+ * not ask for it again. Allocators that give exactly what
+ * is asked need no floor, and it takes no room.
+ *****************************************************/
+template <class Index, bool rounds>
+struct shrinkFloor
+{
+   Index num = std::numeric_limits<Index>::max();
+   DEQUE_CONSTEXPR size_t get() const { return num; }
+   DEQUE_CONSTEXPR void set(size_t numFloor) { num = (Index)numFloor; }
+};
+template <class Index>
+struct shrinkFloor <Index, false>
+{
+   DEQUE_CONSTEXPR size_t get() const { return std::numeric_limits<Index>::max(); }
+   DEQUE_CONSTEXPR void set(size_t) { }
+};
+
+/******************************************************
+ * PROPAGATE ALLOCATOR
+ * Copy, move or swap an allocator only when its
+ * propagate_on_container_* trait is std::true_type. Some
+ * allocators, like std::pmr::polymorphic_allocator, cannot
+ * be assigned at all, so the other branch must not compile.
+ *****************************************************/
+template <class Allocator>
+DEQUE_CONSTEXPR void propagateCopy(Allocator & lhs, const Allocator & rhs, std::true_type) { lhs = rhs; }
+template <class Allocator>
+DEQUE_CONSTEXPR void propagateCopy(Allocator &, const Allocator &, std::false_type) { }
+
+template <class Allocator>
+DEQUE_CONSTEXPR void propagateMove(Allocator & lhs, Allocator & rhs, std::true_type) { lhs = std::move(rhs); }
+template <class Allocator>
+DEQUE_CONSTEXPR void propagateMove(Allocator &, Allocator &, std::false_type) { }
+
+template <class Allocator>
+DEQUE_CONSTEXPR void propagateSwap(Allocator & lhs, Allocator & rhs, std::true_type)
+{
+   using std::swap;
+   swap(lhs, rhs);
+}
+template <class Allocator>
+DEQUE_CONSTEXPR void propagateSwap(Allocator &, Allocator &, std::false_type) { }
+
+/******************************************************
+ * TRIVIAL ELEMENTS
+ * An int needs no destructor and can be copied with memcpy,
+ * but only if the allocator has no construct() or destroy()
+ * of its own that would be skipped.
+ *
+ *    trivial_copy    : relocate and copy with memcpy
+ *    trivial_destroy : pop and clear do nothing per element
+ *****************************************************/
+template <class ...>
+struct voidType { typedef void type; };
+
+template <class Allocator, class T, class = void>
+struct hasConstruct : std::false_type { };
+template <class Allocator, class T>
+struct hasConstruct <Allocator, T, typename voidType<decltype(
+   std::declval<Allocator &>().construct(std::declval<T *>(), std::declval<const T &>()))>::type>
+   : std::true_type { };
+
+template <class Allocator, class T, class = void>
+struct hasDestroy : std::false_type { };
+template <class Allocator, class T>
+struct hasDestroy <Allocator, T, typename voidType<decltype(
+   std::declval<Allocator &>().destroy(std::declval<T *>()))>::type>
+   : std::true_type { };
+
+// C++23 allocate_at_least(n) returns { ptr, count } with count >= n
+template <class Allocator, class = void>
+struct hasAllocateAtLeast : std::false_type { };
+template <class Allocator>
+struct hasAllocateAtLeast <Allocator, typename voidType<decltype(
+   std::declval<Allocator &>().allocate_at_least(size_t()))>::type>
+   : std::true_type { };
+
+// reallocate(p, numOld, numNew) resizes an array without copying, or returns nullptr
+template <class Allocator, class = void>
+struct hasReallocate : std::false_type { };
+template <class Allocator>
+struct hasReallocate <Allocator, typename voidType<decltype(
+   std::declval<Allocator &>().reallocate(
+      std::declval<typename Allocator::value_type *>(), size_t(), size_t()))>::type>
+   : std::true_type { };
+
+template <class Allocator, class T>
+struct customConstruct : hasConstruct<Allocator, T> { };
+template <class Allocator, class T>
+struct customDestroy : hasDestroy<Allocator, T> { };
+
+// before C++20 std::allocator spells out placement new and ~T()
+template <class U, class T>
+struct customConstruct <std::allocator<U>, T> : std::false_type { };
+template <class U, class T>
+struct customDestroy <std::allocator<U>, T> : std::false_type { };
+
+#ifdef DEQUE_PMR
+// polymorphic_allocator only does something different for types that take an allocator
+template <class U, class T>
+struct customConstruct <std::pmr::polymorphic_allocator<U>, T>
+   : std::uses_allocator<T, std::pmr::polymorphic_allocator<U>> { };
+template <class U, class T>
+struct customDestroy <std::pmr::polymorphic_allocator<U>, T> : std::false_type { };
+#endif // DEQUE_PMR
+
+template <class T, class Allocator>
+struct trivial_copy : std::integral_constant<bool,
+   std::is_trivially_copyable<T>::value && !customConstruct<Allocator, T>::value &&
+   !customDestroy<Allocator, T>::value> { };
+
+template <class T, class Allocator>
+struct trivial_destroy : std::integral_constant<bool,
+   std::is_trivially_destructible<T>::value && !customDestroy<Allocator, T>::value> { };
+
+/******************************************************
+ * IS CONSTANT EVALUATED
+ * memcpy cannot run at compile time, so there the trivial
+ * paths copy one element at a time like everyone else
+ *****************************************************/
+inline DEQUE_CONSTEXPR bool isConstantEvaluated()
+{
+#ifdef DEQUE_CONSTEXPR_ALLOC
+   return std::is_constant_evaluated();
+#else
+   return false;
+#endif
+}
+
 /******************************************************
  * DEQUE
  *   0   1   2   3   4
@@ -36,77 +345,238 @@ namespace custom
  * numElements = 3
  * numCapacity = 5
  *****************************************************/
-template <class T>
+template <class T, class Capacity = capacity_any, class Allocator = std::allocator<T>>
 class deque
 {
+   typedef std::allocator_traits<Allocator> alloc_traits;
+   typedef typename Capacity::index_type Index;
+
+   // only an allocator that reports the real count can mirror the array
+   static_assert(!Capacity::mirrored || hasAllocateAtLeast<Allocator>::value,
+                 "a mirrored deque needs an allocator with allocate_at_least");
+
 public:
+   typedef Allocator allocator_type;
 
    // 
    // Construct
    //
 
-   deque() : numElements(0), iaFront(0) { data = nullptr; }
-   deque(int newCapacity);
-   deque(const deque <T> & rhs);
-   ~deque() { 
-       if (numCapacity)
-           delete[] data;
+   DEQUE_CONSTEXPR deque() : numCapacity(0), numElements(0), iaFront(0), alloc() { array = nullptr; }
+   DEQUE_CONSTEXPR explicit deque(const Allocator & alloc)
+      : array(nullptr), numCapacity(0), numElements(0), iaFront(0), alloc(alloc) { }
+   DEQUE_CONSTEXPR deque(size_t newCapacity, const Allocator & alloc = Allocator());
+   template <class InputIt, class = typename std::iterator_traits<InputIt>::iterator_category>
+   DEQUE_CONSTEXPR deque(InputIt first, InputIt last, const Allocator & alloc = Allocator())
+      : deque(alloc) { append(first, last); }
+   DEQUE_CONSTEXPR deque(std::initializer_list<T> il, const Allocator & alloc = Allocator())
+      : deque(alloc) { append(il.begin(), il.end()); }
+   DEQUE_CONSTEXPR deque(const deque & rhs);
+   DEQUE_CONSTEXPR deque(deque && rhs) noexcept
+      : array(rhs.array), numCapacity(rhs.numCapacity),
+        numElements(rhs.numElements), iaFront(rhs.iaFront),
+        alloc(std::move(rhs.alloc))
+   {
+       rhs.array = nullptr;
+       rhs.numCapacity = 0;
+       rhs.numElements = 0;
+       rhs.iaFront = 0;
+   }
+   DEQUE_CONSTEXPR ~deque() { 
        clear(); 
+       deallocate(array, numCapacity);
    }
 
    //
    // Assign | Steve - Done
    //
-   deque<T> & operator = (const deque <T> & rhs);
+   DEQUE_CONSTEXPR deque & operator = (const deque & rhs);
+   DEQUE_CONSTEXPR deque & operator = (deque && rhs)
+      noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+               alloc_traits::is_always_equal::value);
+   DEQUE_CONSTEXPR deque & operator = (std::initializer_list<T> il)
+   {
+       assign(il.begin(), il.end());
+       return *this;
+   }
+   DEQUE_CONSTEXPR void assign(size_t num, const T & t);
+   template <class InputIt, class = typename std::iterator_traits<InputIt>::iterator_category>
+   DEQUE_CONSTEXPR void assign(InputIt first, InputIt last)
+   {
+       clear();
+       append(first, last);
+   }
+   DEQUE_CONSTEXPR void assign(std::initializer_list<T> il) { assign(il.begin(), il.end()); }
+   DEQUE_CONSTEXPR void swap(deque & rhs) noexcept
+   {
+       // allocators that do not propagate must be equal to swap
+       assert(alloc_traits::propagate_on_container_swap::value || alloc == rhs.alloc);
+       std::swap(array,        rhs.array);
+       std::swap(numCapacity, rhs.numCapacity);
+       std::swap(numElements, rhs.numElements);
+       std::swap(iaFront,     rhs.iaFront);
+       propagateSwap(alloc, rhs.alloc,
+                     typename alloc_traits::propagate_on_container_swap());
+   }
 
    //
    // Iterator | Steve - still needs work
    //
    class iterator;
-   iterator begin() { return iterator(this, 0); }
-   iterator end()   { return iterator(this, numElements); }
+   DEQUE_CONSTEXPR iterator begin() { return iterator(this, 0); }
+   DEQUE_CONSTEXPR iterator end()   { return iterator(this, numElements); }
 
    //
    // Access - Shaun
    //
-   T& front();
-   T& back();
-   const T & front() const;
-   const T & back()  const;
+   DEQUE_CONSTEXPR T& front();
+   DEQUE_CONSTEXPR T& back();
+   DEQUE_CONSTEXPR const T & front() const;
+   DEQUE_CONSTEXPR const T & back()  const;
 
    // Steve - Done
-   const T & operator[](size_t index) const;
-         T & operator[](size_t index);
+   DEQUE_CONSTEXPR const T & operator[](size_t index) const;
+   DEQUE_CONSTEXPR       T & operator[](size_t index);
 
    // 
    // Insert - Alex
    //
-   void push_front(const T& t);
-   void push_back(const T& t);
+   DEQUE_CONSTEXPR void push_front(const T& t) { emplace_front(t);            }
+   DEQUE_CONSTEXPR void push_back(const T& t)  { emplace_back(t);             }
+   DEQUE_CONSTEXPR void push_front(T&& t)      { emplace_front(std::move(t)); }
+   DEQUE_CONSTEXPR void push_back(T&& t)       { emplace_back(std::move(t));  }
+   template <class ... Args>
+   DEQUE_CONSTEXPR T & emplace_front(Args && ... args);
+   template <class ... Args>
+   DEQUE_CONSTEXPR T & emplace_back(Args && ... args);
+
+   // a whole range at once: one capacity check, then at most two block copies
+   template <class InputIt>
+   DEQUE_CONSTEXPR void append(InputIt first, InputIt last)
+   {
+       append(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+   }
+   template <class ForwardIt>
+   DEQUE_CONSTEXPR void prepend(ForwardIt first, ForwardIt last);
+
+   // in the middle: whichever side of pos is shorter moves out of the way
+   template <class ForwardIt>
+   DEQUE_CONSTEXPR iterator insert(iterator pos, ForwardIt first, ForwardIt last);
+   DEQUE_CONSTEXPR iterator insert(iterator pos, const T & t)
+   {
+       T value(t);   // t may be one of ours, about to move
+       return insert(pos, std::make_move_iterator(&value), std::make_move_iterator(&value + 1));
+   }
+   DEQUE_CONSTEXPR iterator insert(iterator pos, T && t)
+   {
+       return insert(pos, std::make_move_iterator(&t), std::make_move_iterator(&t + 1));
+   }
    //Required for push front and back
-   void realloc(int num);
+   DEQUE_CONSTEXPR void realloc(int num);
 
    //
    // Remove - Jon
    //
-   void clear() 
+   DEQUE_CONSTEXPR void clear() 
    { 
-       if (numCapacity == 0)
-           return;
-       if (numElements) 
-           for (int id = 0; id < numElements - 1; id++)
-               data[iaFromID(id)] = NULL;
-       
+       destroyIDs(0, numElements);
        numElements = 0; 
+       iaFront = 0;
+   }
+   DEQUE_CONSTEXPR void pop_front();
+   DEQUE_CONSTEXPR void pop_back();
+   DEQUE_CONSTEXPR void pop_front(T & t);   // move the front element into t, then pop it
+   DEQUE_CONSTEXPR void pop_back(T & t);    // move the back element into t, then pop it
+   DEQUE_CONSTEXPR void pop_front_n(size_t num);
+   DEQUE_CONSTEXPR void pop_back_n(size_t num);
+   DEQUE_CONSTEXPR iterator erase(iterator first, iterator last);
+   DEQUE_CONSTEXPR iterator erase(iterator pos)
+   {
+       iterator next = pos;
+       return erase(pos, ++next);
    }
-   void pop_front();
-   void pop_back();
 
    // 
    // Status
    //
-   size_t size() const { return numElements; }
-   bool empty() const  { return numElements == 0; }
+   DEQUE_CONSTEXPR size_t size() const { return numElements; }
+   DEQUE_CONSTEXPR bool empty() const  { return numElements == 0; }
+   DEQUE_CONSTEXPR size_t capacity() const { return numCapacity; }
+   DEQUE_CONSTEXPR size_t max_size() const { return maxCapacity(); }
+
+   // the elements as one run of size(), for mirrored storage only
+   DEQUE_CONSTEXPR T * contiguous()
+   {
+       static_assert(Capacity::mirrored, "only a mirrored deque is contiguous");
+       return array + iaFront;
+   }
+   DEQUE_CONSTEXPR const T * contiguous() const
+   {
+       static_assert(Capacity::mirrored, "only a mirrored deque is contiguous");
+       return array + iaFront;
+   }
+#ifdef DEQUE_SPAN
+   // the elements in place, as one or two runs: the front run then the wrapped rest
+   DEQUE_CONSTEXPR std::pair<std::span<T>, std::span<T>> as_spans()
+   {
+       return front_span(numElements);
+   }
+   DEQUE_CONSTEXPR std::pair<std::span<const T>, std::span<const T>> as_spans() const
+   {
+       return front_span(numElements);
+   }
+   DEQUE_CONSTEXPR std::pair<std::span<T>, std::span<T>> front_span(size_t num)
+   {
+       size_t numFirst = numRun(num);
+       return { std::span<T>(array + iaFront, numFirst), std::span<T>(array, num - numFirst) };
+   }
+   DEQUE_CONSTEXPR std::pair<std::span<const T>, std::span<const T>> front_span(size_t num) const
+   {
+       size_t numFirst = numRun(num);
+       return { std::span<const T>(array + iaFront, numFirst), std::span<const T>(array, num - numFirst) };
+   }
+#endif // DEQUE_SPAN
+
+   //
+   // Buffer: fill the free space behind the back in place, as recv()
+   // or readv() would, then publish what was written. Any change to
+   // the deque, consume() included, invalidates the prepared spans.
+   //
+#ifdef DEQUE_SPAN
+   DEQUE_CONSTEXPR std::pair<std::span<T>, std::span<T>> prepare(size_t num);
+#endif // DEQUE_SPAN
+   DEQUE_CONSTEXPR void commit(size_t num)
+   {
+       static_assert(std::is_trivially_copyable<T>::value, "only plain bytes may be committed");
+       assert(num <= (size_t)numCapacity - numElements);
+       numElements += (Index)num;
+   }
+   DEQUE_CONSTEXPR void consume(size_t num) { pop_front_n(num); }
+
+   // the elements as one run of size(), for a C API that wants a T *
+   DEQUE_CONSTEXPR T * linearize();
+   DEQUE_CONSTEXPR T * data()
+   {
+       assert(numRun(numElements) == numElements);   // linearize() first
+       return array + iaFront;
+   }
+   DEQUE_CONSTEXPR const T * data() const
+   {
+       assert(numRun(numElements) == numElements);
+       return array + iaFront;
+   }
+   DEQUE_CONSTEXPR void reserve(size_t num)
+   {
+       if (num > numCapacity)
+           resize(checkCapacity(Capacity::round(num)));
+   }
+   DEQUE_CONSTEXPR void shrink_to_fit()
+   {
+       size_t newCapacity = Capacity::round(numElements);
+       if (newCapacity < numCapacity)
+           resize((Index)newCapacity);
+   }
+   DEQUE_CONSTEXPR Allocator get_allocator() const { return alloc; }
 
    
 #ifdef DEBUG // make this visible to the unit tests
@@ -116,23 +586,136 @@ private:
 #endif
    
    // fetch array index from the deque index - Shaun
-   int iaFromID(int id) const
+   // No loop and no division: one subtract or one mask. A mirrored
+   // array repeats itself after numCapacity, so it needs neither.
+   DEQUE_CONSTEXPR Index iaFromID(Index id) const
+   {
+       if (Capacity::mirrored)
+           return iaFront + id;
+       return (Index)Capacity::wrap((size_t)iaFront + id, numCapacity);
+   }
+   DEQUE_CONSTEXPR void resize(Index newCapacity = 0);
+   // the biggest array Index can count, and fold a mirrored iaFront + id in
+   static DEQUE_CONSTEXPR size_t maxCapacity()
+   {
+       size_t num = std::numeric_limits<Index>::max();
+       if (Capacity::mirrored)
+           num = num / 2 + 1;
+       return Capacity::largest(num);
+   }
+   // the capacity as an Index, if it fits
+   static DEQUE_CONSTEXPR Index checkCapacity(size_t num)
    {
-       int temp = iaFront + id;
-       if (temp < 0)
-           while (temp < 0)
-               temp += numCapacity;
-       if (numCapacity)
-           return temp % numCapacity;
-       return 0; 
+       if (num > maxCapacity())
+           throw std::length_error("deque too long for its index type");
+       return (Index)num;
    }
-   void resize(int newCapacity = 0);
+   // the capacity for num more elements: the next step of Capacity,
+   // held back to maxCapacity() when that step would not fit
+   DEQUE_CONSTEXPR Index growCapacity(size_t num) const
+   {
+       if (num > maxCapacity() - numElements)
+           throw std::length_error("deque too long for its index type");
+       size_t newCapacity = Capacity::grow(numCapacity);
+       if (newCapacity < (size_t)numElements + num)
+           newCapacity = (size_t)numElements + num;
+       if (newCapacity > maxCapacity())
+           return (Index)maxCapacity();
+       return checkCapacity(Capacity::round(newCapacity));
+   }
+   DEQUE_CONSTEXPR void autoShrink();
+
+   // raw storage: slots are constructed on push and destroyed on pop
+   DEQUE_CONSTEXPR T * allocate(size_t num)
+   {
+       return num ? alloc_traits::allocate(alloc, num) : nullptr;
+   }
+   // allocate num or more slots, setting num to how many we got
+   DEQUE_CONSTEXPR T * allocateAtLeast(size_t & num)
+   {
+       return allocateAtLeast(num, std::integral_constant<bool,
+          fitsAllocator<Capacity>::value && hasAllocateAtLeast<Allocator>::value>());
+   }
+   DEQUE_CONSTEXPR T * allocateAtLeast(size_t & num, std::false_type)
+   {
+       return allocate(num);
+   }
+   DEQUE_CONSTEXPR T * allocateAtLeast(size_t & num, std::true_type)
+   {
+       if (!num)
+           return nullptr;
+       auto result = alloc.allocate_at_least(num);
+       // slots past what Index can count are never used
+       num = result.count;
+       if (num > maxCapacity())
+           num = maxCapacity();
+       return result.ptr;
+   }
+   DEQUE_CONSTEXPR void deallocate(T * p, size_t num)
+   {
+       if (p)
+           alloc_traits::deallocate(alloc, p, num);
+   }
+   template <class ... Args>
+   DEQUE_CONSTEXPR T * construct(T * p, Args && ... args)
+   {
+       alloc_traits::construct(alloc, p, std::forward<Args>(args)...);
+       return p;
+   }
+   DEQUE_CONSTEXPR void destroy(T * p)
+   {
+       if (!trivial_destroy<T, Allocator>::value)
+           alloc_traits::destroy(alloc, p);
+   }
+
+   // of the first num elements, how many come before the wrap point
+   DEQUE_CONSTEXPR size_t numRun(size_t num) const
+   {
+       assert(num <= numElements);
+       size_t numToEnd = numCapacity - iaFront;
+       return numToEnd > num || Capacity::mirrored ? num : numToEnd;
+   }
+
+   // room for num more elements with at most one resize
+   DEQUE_CONSTEXPR void makeRoom(size_t num)
+   {
+       if (num <= (size_t)numCapacity - numElements)
+           return;
+       resize(growCapacity(num));
+   }
+
+   // ranges in up to two runs, either side of the wrap point
+   template <class InputIt>
+   DEQUE_CONSTEXPR void append(InputIt first, InputIt last, std::input_iterator_tag);
+   template <class ForwardIt>
+   DEQUE_CONSTEXPR void append(ForwardIt first, ForwardIt last, std::forward_iterator_tag);
+   template <class ForwardIt>
+   DEQUE_CONSTEXPR void copyRun(T * dest, ForwardIt & first, size_t num);
+   // where a run starts in memory, or nullptr if the iterator is not a pointer
+   template <class P>
+   static DEQUE_CONSTEXPR const void * runAddress(P * p) { return p; }
+   template <class It>
+   static DEQUE_CONSTEXPR const void * runAddress(const It &) { return nullptr; }
+   DEQUE_CONSTEXPR void destroyIDs(size_t idFirst, size_t num);
+   // memmove num trivial elements from iaSrc to iaDst, which is nearer the back or not
+   void shiftSlots(size_t iaSrc, size_t iaDst, size_t num, bool toBack);
+
+   // copy rhs's elements, unwrapped, into the raw array dest
+   DEQUE_CONSTEXPR void copyUnwrapped(T * dest, const deque & rhs, std::true_type);
+   DEQUE_CONSTEXPR void copyUnwrapped(T * dest, const deque & rhs, std::false_type);
+   DEQUE_CONSTEXPR void relocate(T * newData, size_t, std::true_type);
+   DEQUE_CONSTEXPR void relocate(T * newData, size_t newCapacity, std::false_type);
+   DEQUE_CONSTEXPR bool growInPlace(size_t newCapacity, std::true_type);
+   DEQUE_CONSTEXPR bool growInPlace(size_t, std::false_type) { return false; }
 
    // member variables
-   T * data;           // dynamically allocated data for the deque
-   size_t numCapacity; // the size of the data array
-   size_t numElements; // number of elements in the deque
-   int iaFront;        // the index of the first item in the array
+   T * array;          // dynamically allocated array for the deque
+   Index numCapacity;  // the size of the array
+   Index numElements;  // number of elements in the deque
+   Index iaFront;      // the index of the first item in the array
+   DEQUE_NO_UNIQUE_ADDRESS Allocator alloc;    // where the array comes from
+   DEQUE_NO_UNIQUE_ADDRESS shrinkFloor<Index, fitsAllocator<Capacity>::value &&
+      hasAllocateAtLeast<Allocator>::value> floor;   // where autoShrink() gives up
 };
 
 
@@ -141,25 +724,31 @@ private:
  * DEQUE ITERATOR
  * Forward and reverse iterator through a deque, just call
  *********************************************************/
-template <typename T>
-class deque <T> ::iterator
+template <class T, class Capacity, class Allocator>
+class deque <T, Capacity, Allocator> ::iterator
 {
 public:
+   typedef std::bidirectional_iterator_tag iterator_category;
+   typedef T                               value_type;
+   typedef std::ptrdiff_t                  difference_type;
+   typedef T *                             pointer;
+   typedef T &                             reference;
+
    //
    // Construct
    //
-   iterator() : id(0), pDeque(nullptr) { }
-   iterator(custom::deque<T> *pDeque, int id)
+   DEQUE_CONSTEXPR iterator() : id(0), pDeque(nullptr) { }
+   DEQUE_CONSTEXPR iterator(custom::deque<T, Capacity, Allocator> *pDeque, Index id)
    {
        this->id = id;
        this->pDeque = pDeque;
    }
-   iterator(const iterator& rhs) { *this = rhs; }
+   DEQUE_CONSTEXPR iterator(const iterator& rhs) { *this = rhs; }
 
    //
    // Assign
    //
-   iterator& operator = (const iterator& rhs)
+   DEQUE_CONSTEXPR iterator& operator = (const iterator& rhs)
    {
        this->id = rhs.id;
        this->pDeque = rhs.pDeque;
@@ -169,52 +758,52 @@ public:
    //
    // Compare
    //
-   bool operator == (const iterator& rhs) const { return this->pDeque == rhs.pDeque; }
-   bool operator != (const iterator& rhs) const { return this->pDeque != rhs.pDeque; }
+   DEQUE_CONSTEXPR bool operator == (const iterator& rhs) const { return this->pDeque == rhs.pDeque && this->id == rhs.id; }
+   DEQUE_CONSTEXPR bool operator != (const iterator& rhs) const { return !(*this == rhs); }
 
    // 
    // Access
    //
-   const T & operator * () const 
+   DEQUE_CONSTEXPR const T & operator * () const 
    {
-      return pDeque->data[id];
+      return (*pDeque)[id];
    }
-   T & operator * () // Don't think this is quite right
+   DEQUE_CONSTEXPR T & operator * ()
    {
-      return pDeque->data[id];
+      return (*pDeque)[id];
    }
 
    // 
    // Arithmetic
    // 
-   int operator - (iterator it) const
+   DEQUE_CONSTEXPR std::ptrdiff_t operator - (iterator it) const
    {
-      return id - it.id;
+      return (std::ptrdiff_t)id - (std::ptrdiff_t)it.id;
    }
-   iterator& operator += (int offset)
+   DEQUE_CONSTEXPR iterator& operator += (std::ptrdiff_t offset)
    {
-       this->id += offset;
+       this->id = (Index)(this->id + offset);
        return *this;
    }
-   iterator& operator ++ ()
+   DEQUE_CONSTEXPR iterator& operator ++ ()
    {
        this->id++;
        return *this;
    }
-   iterator operator ++ (int postfix)
+   DEQUE_CONSTEXPR iterator operator ++ (int postfix)
    {
-       iterator i = this;
+       iterator i = *this;
        this->id++;
        return i;
    }
-   iterator& operator -- ()
+   DEQUE_CONSTEXPR iterator& operator -- ()
    {
        this->id--;
        return *this;
    }
-   iterator  operator -- (int postfix)
+   DEQUE_CONSTEXPR iterator  operator -- (int postfix)
    {
-       iterator i = this;
+       iterator i = *this;
        this->id--;
        return i;
    }
@@ -224,57 +813,136 @@ public:
 #else
 private:
 #endif
+   friend class deque<T, Capacity, Allocator>;   // insert() and erase() work by id
 
    // Member variables
-   int id;             // deque index
-   deque<T> *pDeque;
+   Index id;           // deque index
+   deque<T, Capacity, Allocator> *pDeque;
 };
 
 
 /****************************************************
  * DEQUE : CONSTRUCTOR - non-default
  ***************************************************/
-template <class T>
-deque <T> :: deque(int newCapacity)
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR deque <T, Capacity, Allocator> :: deque(size_t newCapacity, const Allocator & alloc)
+   : alloc(alloc)
 {
-    // Looks right, but doesn't contribute yet
-    numCapacity = newCapacity;
+    size_t numAllocated = newCapacity > 0 ? checkCapacity(Capacity::round(newCapacity)) : 0;
     numElements = 0;
     iaFront = 0;
 
-    if(newCapacity > 0)
-        data = new T[newCapacity];
-    else
-        data = nullptr;
+    array = allocateAtLeast(numAllocated);
+    numCapacity = (Index)numAllocated;
 }
 
 /****************************************************
  * DEQUE : CONSTRUCTOR - copy
  ***************************************************/
-template <class T>
-deque <T> :: deque(const deque <T> & rhs)
-{  
-   *this = rhs;
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR deque <T, Capacity, Allocator> :: deque(const deque & rhs)
+   : array(nullptr), numCapacity(0), numElements(0), iaFront(0),
+     alloc(alloc_traits::select_on_container_copy_construction(rhs.alloc))
+{
+    // one array of just the size rhs needs, filled a run at a time
+    size_t numAllocated = Capacity::round(rhs.numElements);
+    array = allocateAtLeast(numAllocated);
+    numCapacity = (Index)numAllocated;
+    try
+    {
+        copyUnwrapped(array, rhs, trivial_copy<T, Allocator>());
+    }
+    catch (...)
+    {
+        deallocate(array, numCapacity);
+        throw;
+    }
+    numElements = rhs.numElements;
 }
 
 
 /****************************************************
  * DEQUE : ASSIGNMENT OPERATOR
  ***************************************************/
-template <class T>
-deque <T> & deque <T> :: operator = (const deque <T> & rhs)
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR deque <T, Capacity, Allocator> & deque <T, Capacity, Allocator> :: operator = (const deque & rhs)
 {
-    iaFront = 0;
-    data = new T[rhs.numCapacity];
+    if (this == &rhs)
+        return *this;
 
-    if (numElements < rhs.numElements)
-        resize(rhs.numElements);
+    // destroy what we have, keeping the array if it is big enough
+    clear();
+    if (alloc_traits::propagate_on_container_copy_assignment::value && alloc != rhs.alloc)
+    {
+        // the array belongs to the old allocator
+        deallocate(array, numCapacity);
+        array = nullptr;
+        numCapacity = 0;
+    }
+    propagateCopy(alloc, rhs.alloc,
+                  typename alloc_traits::propagate_on_container_copy_assignment());
+    if (numCapacity < rhs.numElements)
+    {
+        deallocate(array, numCapacity);
+        array = nullptr;
+        numCapacity = 0;
+        size_t numAllocated = Capacity::round(rhs.numElements);
+        array = allocateAtLeast(numAllocated);
+        numCapacity = (Index)numAllocated;
+    }
 
+    // copy-construct the elements, unwrapped, into the front of the array
+    copyUnwrapped(array, rhs, trivial_copy<T, Allocator>());
     numElements = rhs.numElements;
 
-    for (int i = 0; i < numElements; ++i)
-        data[i] = rhs.data[rhs.iaFromID(i)];
+    return *this;
+}
+
+/****************************************************
+ * DEQUE : ASSIGNMENT OPERATOR - move
+ * Take over the array when the allocators allow it.
+ * Otherwise our allocator cannot free rhs's array, so
+ * the elements are moved one at a time.
+ ***************************************************/
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR deque <T, Capacity, Allocator> & deque <T, Capacity, Allocator> :: operator = (deque && rhs)
+   noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+            alloc_traits::is_always_equal::value)
+{
+    if (this == &rhs)
+        return *this;
+
+    if (alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc == rhs.alloc)
+    {
+        clear();
+        deallocate(array, numCapacity);
+        propagateMove(alloc, rhs.alloc,
+                      typename alloc_traits::propagate_on_container_move_assignment());
+        array        = rhs.array;
+        numCapacity = rhs.numCapacity;
+        numElements = rhs.numElements;
+        iaFront     = rhs.iaFront;
+        rhs.array = nullptr;
+        rhs.numCapacity = 0;
+        rhs.numElements = 0;
+        rhs.iaFront = 0;
+        return *this;
+    }
 
+    clear();
+    if (numCapacity < rhs.numElements)
+    {
+        deallocate(array, numCapacity);
+        array = nullptr;
+        numCapacity = 0;
+        size_t numAllocated = Capacity::round(rhs.numElements);
+        array = allocateAtLeast(numAllocated);
+        numCapacity = (Index)numAllocated;
+    }
+    for (; numElements < rhs.numElements; ++numElements)
+        construct(array + numElements, std::move(rhs.array[rhs.iaFromID(numElements)]));
+    rhs.clear();
     return *this;
 }
 
@@ -283,126 +951,742 @@ deque <T> & deque <T> :: operator = (const deque <T> & rhs)
  * DEQUE :: FRONT
  * Fetch the item that is at the beginning of the deque
  *************************************************/
-template <class T>
-const T & deque <T> :: front() const 
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR const T & deque <T, Capacity, Allocator> :: front() const 
 {
-    return data[iaFromID(iaFront)];
+    return array[iaFront];
 }
-template <class T>
-T& deque <T> ::front()
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR T& deque <T, Capacity, Allocator> ::front()
 {
-    return data[iaFromID(iaFront)]; 
+    return array[iaFront]; 
 }
 
 /**************************************************
  * DEQUE :: BACK
  * Fetch the item that is at the end of the deque
  *************************************************/
-template <class T>
-const T & deque <T> :: back() const 
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR const T & deque <T, Capacity, Allocator> :: back() const 
 {
-    return data[iaFromID(numElements - 1)];
+    return array[iaFromID(numElements - 1)];
 }
 
-template <class T>
-T& deque <T> ::back()
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR T& deque <T, Capacity, Allocator> ::back()
 {
-    return data[iaFromID(numElements-1)];
+    return array[iaFromID(numElements-1)];
 }
 
 /**************************************************
  * DEQUE :: SUBSCRIPT
  * Fetch the item in the deque
  *************************************************/
-template <class T>
-const T& deque <T> ::operator[](size_t index) const
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR const T& deque <T, Capacity, Allocator> ::operator[](size_t index) const
 {
-    return data[iaFromID(index)];
+    return array[iaFromID((Index)index)];
 }
-template <class T>
-T& deque <T> ::operator[](size_t index)
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR T& deque <T, Capacity, Allocator> ::operator[](size_t index)
 {
-    return data[iaFromID(index)];
+    return array[iaFromID((Index)index)];
 }
 
 /*****************************************************
  * DEQUE : POP_BACK
  *****************************************************/
-template <class T>
-void deque <T> :: pop_back()
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR void deque <T, Capacity, Allocator> :: pop_back()
 {
     numElements--;
-    data[iaFromID(numElements)] = NULL;
+    destroy(array + iaFromID(numElements));
+    autoShrink();
 }
 
 /*****************************************************
  * DEQUE : POP_FRONT
  *****************************************************/
-template <class T>
-void deque <T> :: pop_front()
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR void deque <T, Capacity, Allocator> :: pop_front()
 {
     numElements--; 
-    data[iaFromID(0)] = NULL;
-    iaFront++;
-    if (iaFront == numCapacity)
-        iaFront = 0;
+    destroy(array + iaFront);
+    iaFront = (Index)Capacity::wrap((size_t)iaFront + 1, numCapacity);
+    autoShrink();
+}
+
+/*****************************************************
+ * DEQUE : POP_BACK - move out
+ * Hand the last element to the caller before removing it
+ *****************************************************/
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR void deque <T, Capacity, Allocator> :: pop_back(T & t)
+{
+    t = std::move(back());
+    pop_back();
+}
+
+/*****************************************************
+ * DEQUE : POP_FRONT - move out
+ * Hand the first element to the caller before removing it
+ *****************************************************/
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR void deque <T, Capacity, Allocator> :: pop_front(T & t)
+{
+    t = std::move(front());
+    pop_front();
 }
 
 /******************************************************
- * DEQUE : PUSH_BACK
+ * DEQUE : EMPLACE_BACK
+ * Construct the new element directly in the slot past the
+ * end. When the deque is full the element is built first so
+ * that args may still refer to one of our own elements while
+ * the array moves.
  ******************************************************/
-template <class T>
-void deque <T> :: push_back(const T & t)
+template <class T, class Capacity, class Allocator>
+template <class ... Args>
+DEQUE_CONSTEXPR T & deque <T, Capacity, Allocator> :: emplace_back(Args && ... args)
 {
    if (numElements == numCapacity)
    {
-      if (numCapacity == 0)         // Give the deque a place to live 
-         resize(1);
-      else
-         resize(numCapacity * 2);      // Give the deque more double space if it's out of space.
+      T t(std::forward<Args>(args)...);
+      resize(growCapacity(1));   // Give the deque more space if it's out of space.
+      return emplace_back(std::move(t));
    }
-   data[iaFromID(numElements++)] = t;      // Place the new element on the end
+   T * p = construct(array + iaFromID(numElements), std::forward<Args>(args)...);
+   numElements++;
+   return *p;
 }
 
 /******************************************************
- * DEQUE : PUSH_FRONT
+ * DEQUE : EMPLACE_FRONT
+ * Construct the new element directly in the slot before
+ * the front, folding -1 around to numCapacity - 1
  ******************************************************/
-template <class T>
-void deque <T> :: push_front(const T & t)
+template <class T, class Capacity, class Allocator>
+template <class ... Args>
+DEQUE_CONSTEXPR T & deque <T, Capacity, Allocator> :: emplace_front(Args && ... args)
 {
-   if (numElements == numCapacity) {
-      if (numCapacity == 0) {      // Give the deque a place to live
-         resize(1);
-      }
-      else
-         resize(numCapacity * 2);   // Give the deque more double space if it's out of space.
-   }
-   int temp = iaFront--;         // iaFront at before 0
-   if (temp < 0 ) {
-      temp = numCapacity - 1;
+   if (numElements == numCapacity)
+   {
+      T t(std::forward<Args>(args)...);
+      resize(growCapacity(1));   // Give the deque more space if it's out of space.
+      return emplace_front(std::move(t));
    }
-   data[iaFromID(temp)] = t;
+
+   Index iaNew = (Index)Capacity::wrap((size_t)iaFront + numCapacity - 1, numCapacity);
+   T * p = construct(array + iaNew, std::forward<Args>(args)...);
+   iaFront = iaNew;
    numElements++;                   // Increment the number of elements
+   return *p;
+}
+
+/****************************************************
+ * DEQUE :: COPY UNWRAPPED
+ * Copy-construct rhs's elements into dest, front first.
+ * The live part of rhs is at most two runs, either side of
+ * the wrap point. Trivial elements take one memcpy each:
+ *
+ *     rhs.array                     dest
+ *   +---+---+---+---+---+        +---+---+---+---+
+ *   | C | D |   | A | B |   ->   | A | B | C | D |
+ *   +---+---+---+---+---+        +---+---+---+---+
+ ***************************************************/
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR void deque <T, Capacity, Allocator> :: copyUnwrapped(T * dest, const deque & rhs, std::true_type)
+{
+    if (isConstantEvaluated())
+        return copyUnwrapped(dest, rhs, std::false_type());
+    if (rhs.numElements == 0)
+        return;
+    size_t numFirst = rhs.numRun(rhs.numElements);
+    std::memcpy(dest, rhs.array + rhs.iaFront, numFirst * sizeof(T));
+    if (numFirst < rhs.numElements)
+        std::memcpy(dest + numFirst, rhs.array, (rhs.numElements - numFirst) * sizeof(T));
+}
+
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR void deque <T, Capacity, Allocator> :: copyUnwrapped(T * dest, const deque & rhs, std::false_type)
+{
+    size_t numFirst = rhs.numRun(rhs.numElements);
+    size_t i = 0;
+    try
+    {
+        for (const T * p = rhs.array + rhs.iaFront; i < numFirst; i++)
+            construct(dest + i, *p++);
+        for (const T * p = rhs.array; i < rhs.numElements; i++)
+            construct(dest + i, *p++);
+    }
+    catch (...)
+    {
+        while (i--)
+            destroy(dest + i);
+        throw;
+    }
+}
+
+/****************************************************
+ * DEQUE :: RELOCATE
+ * Move the elements, unwrapped, into newData and free the
+ * old array. Trivial elements are copied with memcpy and
+ * need no destructor. Others are moved when T's move cannot
+ * throw and copied otherwise, and if that throws nothing
+ * has changed.
+ ***************************************************/
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR void deque <T, Capacity, Allocator> :: relocate(T * newData, size_t, std::true_type)
+{
+    copyUnwrapped(newData, *this, std::true_type());
+    deallocate(array, numCapacity);
+}
+
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR void deque <T, Capacity, Allocator> :: relocate(T * newData, size_t newCapacity, std::false_type)
+{
+    Index i = 0;
+    try
+    {
+        for (; i < numElements; i++)
+            construct(newData + i, std::move_if_noexcept(array[iaFromID(i)]));
+    }
+    catch (...)
+    {
+        while (i--)
+            destroy(newData + i);
+        deallocate(newData, newCapacity);
+        throw;
+    }
+
+    for (i = 0; i < numElements; i++)
+        destroy(array + iaFromID(i));
+    deallocate(array, numCapacity);
+}
+
+/****************************************************
+ * DEQUE :: GROW IN PLACE
+ * Let the allocator extend the array, say with mremap,
+ * without copying it. Then only one run of the elements
+ * must move: the wrapped prefix goes after the old end,
+ * or the front run goes to the new end, whichever is
+ * shorter.
+ *
+ *   +---+---+---+---+---+         +---+---+---+---+---+---+---+---+
+ *   | D |   | A | B | C |   ->    |   |   | A | B | C | D |   |   |
+ *   +---+---+---+---+---+         +---+---+---+---+---+---+---+---+
+ ***************************************************/
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR bool deque <T, Capacity, Allocator> :: growInPlace(size_t newCapacity, std::true_type)
+{
+    if (array == nullptr || newCapacity <= numCapacity)
+        return false;
+    T * newData = alloc.reallocate(array, numCapacity, newCapacity);
+    if (newData == nullptr)
+        return false;
+    array = newData;
+
+    size_t numFront = numCapacity - iaFront;   // from iaFront to the old end
+    if (numElements > numFront)
+    {
+        size_t numPrefix = numElements - numFront;
+        if (numPrefix <= numFront && numCapacity + numPrefix <= newCapacity)
+            std::memcpy(array + numCapacity, array, numPrefix * sizeof(T));
+        else
+        {
+            size_t iaNew = newCapacity - numFront;
+            std::memmove(array + iaNew, array + iaFront, numFront * sizeof(T));
+            iaFront = (Index)iaNew;
+        }
+    }
+    numCapacity = (Index)newCapacity;
+    return true;
+}
+
+/****************************************************
+ * DEQUE :: LINEARIZE
+ * Rotate a wrapped deque in place so the front lands in
+ * slot 0. An unwrapped deque is left where it is. First
+ * the front run slides down against the back run, filling
+ * the free slots between them, then the two swap places:
+ *
+ *   | C | D |   | A | B |  ->  | C | D | A | B |   |  ->  | A | B | C | D |   |
+ *
+ * This gives the basic guarantee. If a move throws while
+ * sliding, the elements already slid are moved back, the
+ * free slots are destroyed again, and the deque keeps its
+ * old layout. If moving back throws as well, those elements
+ * are left moved-from. If a move throws while swapping, the
+ * deque is already unwrapped but its order is unspecified.
+ ***************************************************/
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR T * deque <T, Capacity, Allocator> :: linearize()
+{
+    size_t numFirst = numRun(numElements);
+    if (numFirst == numElements)
+        return array + iaFront;
 
+    size_t numSecond = numElements - numFirst;
+    size_t i = 0;
+    try
+    {
+        for (; numSecond < iaFront && i < numFirst; i++)   // no free slots, no slide
+        {
+            if (numSecond + i < iaFront)
+                construct(array + numSecond + i, std::move(array[iaFront + i]));
+            else
+                array[numSecond + i] = std::move(array[iaFront + i]);
+        }
+    }
+    catch (...)
+    {
+        size_t numSlid = i;
+        try
+        {
+            while (i--)   // last slid first, undoing any overlap
+                array[iaFront + i] = std::move(array[numSecond + i]);
+        }
+        catch (...)
+        {
+            // the rest stay moved-from
+        }
+        for (size_t ia = numSecond; ia < numSecond + numSlid && ia < iaFront; ia++)
+            destroy(array + ia);
+        throw;
+    }
+    for (size_t ia = iaFront > numElements ? iaFront : numElements; ia < numCapacity; ia++)
+        destroy(array + ia);
+
+    iaFront = 0;
+    std::rotate(array, array + numSecond, array + numElements);
+    return array;
 }
+
 /****************************************************
  * DEQUE :: GROW
- * If the deque is currently empty, allocate to size 2.
- * Otherwise, double the size
+ * Move to an array of newCapacity slots, unwrapping the
+ * elements so the front lands in slot 0. Only the live
+ * elements are constructed in the new array.
  ***************************************************/
-template <class T>
-void deque <T> :: resize(int newCapacity) // - Steve 
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR void deque <T, Capacity, Allocator> :: resize(Index newCapacity) // - Steve 
 {
-    T* newData = new T[newCapacity];
+    if (growInPlace(newCapacity, std::integral_constant<bool,
+           trivial_copy<T, Allocator>::value && hasReallocate<Allocator>::value>()))
+        return;
 
-    for (int i = 0; i < numElements ; i++)
-        newData[i] = data[i];
+    size_t numAllocated = newCapacity;
+    T* newData = allocateAtLeast(numAllocated);
+    relocate(newData, numAllocated, trivial_copy<T, Allocator>());
 
-    numCapacity = newCapacity;
+    array = newData;
+    numCapacity = (Index)numAllocated;
     iaFront = 0;
+}
+
+/****************************************************
+ * DEQUE :: AUTO SHRINK
+ * Move to a smaller array when Capacity says to. If the
+ * allocator rounds the request back up to the array we
+ * already have, the new one is given back and the request
+ * becomes the floor. Below the floor Capacity is asked
+ * again as if the array were already that small, so each
+ * pop costs nothing and each step down is tried only once.
+ ***************************************************/
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR void deque <T, Capacity, Allocator> :: autoShrink()
+{
+    size_t newCapacity = Capacity::shrink(numElements, numCapacity);
+    while (newCapacity >= floor.get() && newCapacity < numCapacity)
+    {
+        size_t smaller = Capacity::shrink(numElements, newCapacity);
+        if (smaller == newCapacity)
+            return;
+        newCapacity = smaller;
+    }
+    if (newCapacity >= numCapacity)
+        return;
 
-    delete[]data;
-    data = newData;
+    try
+    {
+        size_t numAllocated = newCapacity;
+        T * newData = allocateAtLeast(numAllocated);
+        if (numAllocated >= numCapacity)
+        {
+            deallocate(newData, numAllocated);
+            floor.set(newCapacity);
+            return;
+        }
+        relocate(newData, numAllocated, trivial_copy<T, Allocator>());
+        array = newData;
+        numCapacity = (Index)numAllocated;
+        iaFront = 0;
+    }
+    catch (...)
+    {
+        // keep the bigger array, a pop must not fail
+    }
 }
 
+/******************************************************
+ * DEQUE : COPY RUN
+ * Copy-construct num elements from first into the raw
+ * slots at dest, leaving first just past them. A run of
+ * trivial elements from a pointer is a single memcpy. If
+ * a constructor throws, the run is undone.
+ ******************************************************/
+template <class T, class Capacity, class Allocator>
+template <class ForwardIt>
+DEQUE_CONSTEXPR void deque <T, Capacity, Allocator> :: copyRun(T * dest, ForwardIt & first, size_t num)
+{
+    if (trivial_copy<T, Allocator>::value && std::is_pointer<ForwardIt>::value &&
+        std::is_same<typename std::iterator_traits<ForwardIt>::value_type, T>::value &&
+        !isConstantEvaluated())
+    {
+        if (num)
+            std::memcpy((void *)dest, runAddress(first), num * sizeof(T));
+        std::advance(first, num);
+        return;
+    }
+
+    size_t i = 0;
+    try
+    {
+        for (; i < num; i++, ++first)
+            construct(dest + i, *first);
+    }
+    catch (...)
+    {
+        while (i--)
+            destroy(dest + i);
+        throw;
+    }
+}
+
+/******************************************************
+ * DEQUE : DESTROY IDS
+ * Destroy the elements idFirst .. idFirst + num - 1, a
+ * run on each side of the wrap point
+ ******************************************************/
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR void deque <T, Capacity, Allocator> :: destroyIDs(size_t idFirst, size_t num)
+{
+    if (trivial_destroy<T, Allocator>::value || num == 0)
+        return;
+    size_t ia = iaFromID((Index)idFirst);
+    size_t numFirst = Capacity::mirrored || num <= numCapacity - ia ? num : numCapacity - ia;
+    for (T * p = array + ia; p != array + ia + numFirst; ++p)
+        destroy(p);
+    for (T * p = array; p != array + (num - numFirst); ++p)
+        destroy(p);
+}
+
+/******************************************************
+ * DEQUE : APPEND
+ * A single-pass range cannot be measured first, so it
+ * goes one element at a time. Anything else is counted,
+ * room is made once, and the elements are copied behind
+ * the back in at most two runs:
+ *
+ *            back                              front
+ *   +---+---+---+---+---+---+       +---+---+---+---+---+---+
+ *   | A |   |   |   |   |   |   ->  | A | B | C | D | E |   |
+ *   +---+---+---+---+---+---+       +---+---+---+---+---+---+
+ ******************************************************/
+template <class T, class Capacity, class Allocator>
+template <class InputIt>
+DEQUE_CONSTEXPR void deque <T, Capacity, Allocator> :: append(InputIt first, InputIt last,
+                                                              std::input_iterator_tag)
+{
+    for (; first != last; ++first)
+        emplace_back(*first);
+}
+
+template <class T, class Capacity, class Allocator>
+template <class ForwardIt>
+DEQUE_CONSTEXPR void deque <T, Capacity, Allocator> :: append(ForwardIt first, ForwardIt last,
+                                                              std::forward_iterator_tag)
+{
+    size_t num = (size_t)std::distance(first, last);
+    if (num == 0)
+        return;
+    makeRoom(num);
+
+    size_t iaBack = iaFromID(numElements);
+    size_t numFirst = Capacity::mirrored || num <= numCapacity - iaBack ? num : numCapacity - iaBack;
+    copyRun(array + iaBack, first, numFirst);
+    numElements += (Index)numFirst;
+    copyRun(array, first, num - numFirst);
+    numElements += (Index)(num - numFirst);
+}
+
+/******************************************************
+ * DEQUE : PREPEND
+ * Put [first, last) in front of the deque, in order.
+ * The new front is found first, then filled forward in
+ * at most two runs. If a copy throws, nothing changes.
+ ******************************************************/
+template <class T, class Capacity, class Allocator>
+template <class ForwardIt>
+DEQUE_CONSTEXPR void deque <T, Capacity, Allocator> :: prepend(ForwardIt first, ForwardIt last)
+{
+    size_t num = (size_t)std::distance(first, last);
+    if (num == 0)
+        return;
+    makeRoom(num);
+
+    size_t iaNew = Capacity::wrap((size_t)iaFront + numCapacity - num, numCapacity);
+    size_t numFirst = Capacity::mirrored || num <= numCapacity - iaNew ? num : numCapacity - iaNew;
+    copyRun(array + iaNew, first, numFirst);
+    try
+    {
+        copyRun(array, first, num - numFirst);
+    }
+    catch (...)
+    {
+        for (size_t i = 0; i < numFirst; i++)
+            destroy(array + iaNew + i);
+        throw;
+    }
+    iaFront = (Index)iaNew;
+    numElements += (Index)num;
+}
+
+#ifdef DEQUE_SPAN
+/******************************************************
+ * DEQUE : PREPARE
+ * The next num free slots behind the back, growing once
+ * if there are too few. Like the elements, they come in
+ * at most two runs: up to the end of the array, then from
+ * array[0]. Nothing is constructed there, so T must be a
+ * type that writing bytes can bring to life.
+ ******************************************************/
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR std::pair<std::span<T>, std::span<T>> deque <T, Capacity, Allocator> :: prepare(size_t num)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "only plain bytes may be prepared");
+    makeRoom(num);
+
+    size_t iaBack = iaFromID(numElements);
+    size_t numFirst = Capacity::mirrored || num <= numCapacity - iaBack ? num : numCapacity - iaBack;
+    return { std::span<T>(array + iaBack, numFirst), std::span<T>(array, num - numFirst) };
+}
+#endif // DEQUE_SPAN
+
+/******************************************************
+ * DEQUE : ASSIGN
+ * Replace the elements with num copies of t. t may be
+ * one of our own elements, so it is copied out first.
+ ******************************************************/
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR void deque <T, Capacity, Allocator> :: assign(size_t num, const T & t)
+{
+    T value(t);
+    clear();
+    makeRoom(num);
+    for (; numElements < num; numElements++)
+        construct(array + numElements, value);
+}
+
+/******************************************************
+ * DEQUE : INSERT
+ * Put [first, last) in front of pos. Only the elements
+ * on the shorter side of pos move, so the cost is
+ * O(min(id, size() - id)) plus the new elements:
+ *
+ *    front side shorter:  [ A B | E F G ]  ->  [ A B x y | E F G ]
+ *                            <--                  moved
+ *
+ * Trivial elements slide as raw blocks, at most a few
+ * memmoves either side of the wrap point. Anything else is
+ * added at the near end, strongly, then rotated into place.
+ ******************************************************/
+template <class T, class Capacity, class Allocator>
+template <class ForwardIt>
+DEQUE_CONSTEXPR typename deque <T, Capacity, Allocator> ::iterator
+deque <T, Capacity, Allocator> :: insert(iterator pos, ForwardIt first, ForwardIt last)
+{
+    assert(pos.pDeque == this && pos.id <= numElements);
+    size_t id = pos.id;
+    size_t num = (size_t)std::distance(first, last);
+    if (num == 0)
+        return iterator(this, (Index)id);
+    bool toFront = id < numElements - id;
+
+    if (trivial_copy<T, Allocator>::value && !isConstantEvaluated())
+    {
+        makeRoom(num);
+        if (toFront)
+        {
+            size_t iaNew = Capacity::wrap((size_t)iaFront + numCapacity - num, numCapacity);
+            shiftSlots(iaFront, iaNew, id, false);
+            iaFront = (Index)iaNew;
+        }
+        else
+            shiftSlots(Capacity::wrap((size_t)iaFront + id, numCapacity), Capacity::wrap((size_t)iaFront + id + num, numCapacity),
+                       numElements - id, true);
+
+        size_t ia = Capacity::wrap((size_t)iaFront + id, numCapacity);
+        size_t numFirst = Capacity::mirrored || num <= numCapacity - ia ? num : numCapacity - ia;
+        copyRun(array + ia, first, numFirst);
+        copyRun(array, first, num - numFirst);
+        numElements += (Index)num;
+    }
+    else if (toFront)
+    {
+        prepend(first, last);
+        std::rotate(begin(), iterator(this, (Index)num), iterator(this, (Index)(num + id)));
+    }
+    else
+    {
+        size_t numOld = numElements;
+        try
+        {
+            append(first, last);
+        }
+        catch (...)
+        {
+            destroyIDs(numOld, numElements - numOld);
+            numElements = (Index)numOld;
+            throw;
+        }
+        std::rotate(iterator(this, (Index)id), iterator(this, (Index)numOld), end());
+    }
+    return iterator(this, (Index)id);
+}
+
+/******************************************************
+ * DEQUE : ERASE
+ * Remove [first, last). The shorter side closes the gap,
+ * then the elements left over at that end are destroyed.
+ ******************************************************/
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR typename deque <T, Capacity, Allocator> ::iterator
+deque <T, Capacity, Allocator> :: erase(iterator first, iterator last)
+{
+    assert(first.pDeque == this && last.pDeque == this);
+    assert(first.id <= last.id && last.id <= numElements);
+    size_t id = first.id;
+    size_t num = last.id - first.id;
+    if (num == 0)
+        return first;
+    size_t numAfter = numElements - id - num;
+    bool trivial = trivial_copy<T, Allocator>::value && !isConstantEvaluated();
+
+    if (id < numAfter)
+    {
+        size_t iaNew = Capacity::wrap((size_t)iaFront + num, numCapacity);
+        if (trivial)
+            shiftSlots(iaFront, iaNew, id, true);
+        else
+            std::move_backward(begin(), first, last);
+        destroyIDs(0, num);
+        iaFront = (Index)iaNew;
+    }
+    else
+    {
+        if (trivial)
+            shiftSlots(Capacity::wrap((size_t)iaFront + id + num, numCapacity),
+                       Capacity::wrap((size_t)iaFront + id, numCapacity), numAfter, false);
+        else
+            std::move(last, end(), first);
+        destroyIDs(numElements - num, num);
+    }
+    numElements -= (Index)num;
+    autoShrink();
+    return iterator(this, (Index)id);
+}
+
+/******************************************************
+ * DEQUE : SHIFT SLOTS
+ * Move num trivial elements from the slots starting at
+ * iaSrc to those starting at iaDst, one memmove per run
+ * between wrap points. Moving toward the back goes from
+ * the last run down so no source is overwritten first.
+ ******************************************************/
+template <class T, class Capacity, class Allocator>
+void deque <T, Capacity, Allocator> :: shiftSlots(size_t iaSrc, size_t iaDst, size_t num, bool toBack)
+{
+    if (!toBack)
+    {
+        while (num)
+        {
+            size_t numChunk = std::min(num, std::min(numCapacity - iaSrc, numCapacity - iaDst));
+            std::memmove((void *)(array + iaDst), (const void *)(array + iaSrc), numChunk * sizeof(T));
+            iaSrc = Capacity::wrap(iaSrc + numChunk, numCapacity);
+            iaDst = Capacity::wrap(iaDst + numChunk, numCapacity);
+            num -= numChunk;
+        }
+        return;
+    }
+
+    // one past the last slot of each, in 1 .. numCapacity
+    iaSrc = Capacity::wrap(iaSrc + num, numCapacity);
+    iaDst = Capacity::wrap(iaDst + num, numCapacity);
+    while (num)
+    {
+        if (iaSrc == 0)
+            iaSrc = numCapacity;
+        if (iaDst == 0)
+            iaDst = numCapacity;
+        size_t numChunk = std::min(num, std::min(iaSrc, iaDst));
+        iaSrc -= numChunk;
+        iaDst -= numChunk;
+        std::memmove((void *)(array + iaDst), (const void *)(array + iaSrc), numChunk * sizeof(T));
+        num -= numChunk;
+    }
+}
+
+/*****************************************************
+ * DEQUE : POP_FRONT_N and POP_BACK_N
+ * Remove num elements from one end, then shrink once
+ *****************************************************/
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR void deque <T, Capacity, Allocator> :: pop_front_n(size_t num)
+{
+    assert(num <= numElements);
+    destroyIDs(0, num);
+    iaFront = (Index)Capacity::wrap((size_t)iaFront + num, numCapacity);
+    numElements -= (Index)num;
+    autoShrink();
+}
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR void deque <T, Capacity, Allocator> :: pop_back_n(size_t num)
+{
+    assert(num <= numElements);
+    destroyIDs(numElements - num, num);
+    numElements -= (Index)num;
+    autoShrink();
+}
+
+/******************************************************
+ * SWAP
+ ******************************************************/
+template <class T, class Capacity, class Allocator>
+DEQUE_CONSTEXPR void swap(deque <T, Capacity, Allocator> & lhs, deque <T, Capacity, Allocator> & rhs) noexcept
+{
+   lhs.swap(rhs);
+}
+
+#ifdef DEQUE_PMR
+/******************************************************
+ * PMR DEQUE
+ * A deque whose arrays come from a std::pmr::memory_resource,
+ * such as a monotonic arena that is released all at once:
+ *
+ *    std::pmr::monotonic_buffer_resource arena;
+ *    custom::pmr::deque<int> d(&arena);
+ ******************************************************/
+namespace pmr
+{
+   template <class T, class Capacity = capacity_any>
+   using deque = custom::deque<T, Capacity, std::pmr::polymorphic_allocator<T>>;
+}
+#endif // DEQUE_PMR
+
 } // namespace custom
+
+#include "segmentedDeque.h"     // deque<T, segmented<numBlock>>
+#include "incrementalDeque.h"   // deque<T, incremental<numStep>>
+#include "smallDeque.h"         // deque<T, small_buffer<numInline>>, small_deque
+#include "staticDeque.h"        // deque<T, static_buffer<numCapacity>>, static_deque
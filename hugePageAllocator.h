@@ -0,0 +1,149 @@
+/***********************************************************************
+ * Header:
+ *    HUGE PAGE ALLOCATOR
+ * Summary:
+ *    An allocator that backs big arrays with 2MB pages, so random
+ *    access into a multi-gigabyte deque needs far fewer TLB entries:
+ *
+ *        custom::deque<int, custom::capacity_usable<>,
+ *                      custom::huge_page_allocator<int>> d;
+ *
+ *    Linux only. Elsewhere DEQUE_HUGEPAGE is not defined and the
+ *    header is empty.
+ *
+ *    This will contain the class definition of:
+ *        huge_page_allocator   : big arrays 2MB-aligned and huge-page backed
+ * Author
+ *    Alexander Dohms, Stephen Costigan, Shaun Crook, Jonathan Colwell
+ ************************************************************************/
+
+#pragma once
+
+#ifdef __linux__
+#ifndef DEQUE_HUGEPAGE
+#define DEQUE_HUGEPAGE       // madvise and MAP_HUGETLB are Linux
+#endif
+
+#include <cstddef>           // for size_t
+#include <cstdint>           // for uintptr_t
+#include <new>               // for ::operator new, std::bad_alloc
+#include <type_traits>       // for std::true_type
+#include <sys/mman.h>        // for mmap, munmap, madvise
+
+namespace custom
+{
+
+/******************************************************
+ * HUGE PAGE ALLOCATOR
+ * Arrays of numThreshold bytes or more are rounded up to
+ * whole 2MB pages and mapped on a 2MB boundary:
+ *
+ *   1. with useHugeTLB, ask for reserved huge pages with
+ *      MAP_HUGETLB. Few systems reserve any, so a failure
+ *      is quietly ignored.
+ *   2. otherwise map 2MB more than needed, unmap the ends
+ *      so what is left is aligned, and madvise the kernel
+ *      to back it with transparent huge pages. The advice
+ *      is only a hint and may be ignored.
+ *
+ * Smaller arrays come from ::operator new. The rounding is
+ * reported through allocate_at_least(), so capacity_usable
+ * puts it to work instead of wasting it.
+ *****************************************************/
+template <class T, size_t numThreshold = (size_t)2 << 20, bool useHugeTLB = false>
+class huge_page_allocator
+{
+public:
+   typedef T value_type;
+   typedef std::true_type is_always_equal;
+   template <class U>
+   struct rebind { typedef huge_page_allocator<U, numThreshold, useHugeTLB> other; };
+
+   struct allocation_result
+   {
+      T * ptr;
+      size_t count;
+   };
+
+   static const size_t numHuge = (size_t)2 << 20;   // 2MB
+
+   huge_page_allocator() noexcept { }
+   template <class U>
+   huge_page_allocator(const huge_page_allocator<U, numThreshold, useHugeTLB> &) noexcept { }
+
+   allocation_result allocate_at_least(size_t num)
+   {
+      if (num > ((size_t)-1 - 2 * numHuge) / sizeof(T))
+         throw std::bad_alloc();
+      size_t numBytes = num * sizeof(T);
+      if (numBytes < numThreshold)
+         return { static_cast<T *>(::operator new(numBytes)), num };
+
+      numBytes = hugeRound(numBytes);
+      return { static_cast<T *>(mapHuge(numBytes)), numBytes / sizeof(T) };
+   }
+   T * allocate(size_t num)
+   {
+      return allocate_at_least(num).ptr;
+   }
+   void deallocate(T * p, size_t num)
+   {
+      size_t numBytes = num * sizeof(T);
+      if (numBytes < numThreshold)
+         ::operator delete(p);
+      else
+         munmap(p, hugeRound(numBytes));
+   }
+
+   template <class U>
+   bool operator == (const huge_page_allocator<U, numThreshold, useHugeTLB> &) const { return true;  }
+   template <class U>
+   bool operator != (const huge_page_allocator<U, numThreshold, useHugeTLB> &) const { return false; }
+
+#ifdef DEBUG // make this visible to the unit tests
+public:
+#else
+private:
+#endif
+
+   static size_t hugeRound(size_t numBytes)
+   {
+      return (numBytes + numHuge - 1) / numHuge * numHuge;
+   }
+
+   // numBytes is a whole number of huge pages
+   static void * mapHuge(size_t numBytes)
+   {
+#ifdef MAP_HUGETLB
+      if (useHugeTLB)
+      {
+         void * p = mmap(nullptr, numBytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+         if (p != MAP_FAILED)
+            return p;
+      }
+#endif // MAP_HUGETLB
+
+      char * p = static_cast<char *>(mmap(nullptr, numBytes + numHuge, PROT_READ | PROT_WRITE,
+                                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+      if (p == MAP_FAILED)
+         throw std::bad_alloc();
+
+      // trim the slack so the array starts on a 2MB boundary
+      size_t numHead = (numHuge - (uintptr_t)p % numHuge) % numHuge;
+      if (numHead)
+         munmap(p, numHead);
+      if (numHuge - numHead)
+         munmap(p + numHead + numBytes, numHuge - numHead);
+      p += numHead;
+
+#ifdef MADV_HUGEPAGE
+      madvise(p, numBytes, MADV_HUGEPAGE);
+#endif // MADV_HUGEPAGE
+      return p;
+   }
+};
+
+} // namespace custom
+
+#endif // __linux__
@@ -0,0 +1,573 @@
+/***********************************************************************
+ * Header:
+ *    INCREMENTAL DEQUE
+ * Summary:
+ *    The incremental-growth storage engine for custom::deque. Selected
+ *    with the second template parameter:
+ *
+ *        custom::deque<T, custom::incremental<4>>
+ *
+ *    This will contain the class definition of:
+ *        incremental             : tag selecting the engine and step size
+ *        deque<T, incremental>   : a ring that grows without a pause
+ *        deque::iterator         : An iterator through the deque
+ * Author
+ *    Alexander Dohms, Stephen Costigan, Shaun Crook, Jonathan Colwell
+ ************************************************************************/
+
+#pragma once
+
+#include "deque.h"   // for the primary deque template
+
+namespace custom
+{
+
+/******************************************************
+ * INCREMENTAL
+ * Storage engine tag. Every push and pop moves up to
+ * numStep elements out of the old array.
+ *****************************************************/
+template <size_t numStep = 4>
+struct incremental
+{
+   static_assert(numStep > 0, "incremental must migrate at least one element per step");
+   static const size_t step = numStep;
+};
+
+/******************************************************
+ * DEQUE : INCREMENTAL
+ * A ring like the primary deque, except that a full ring
+ * is not copied all at once. It allocates the doubled array
+ * and leaves the elements where they are. Each later push
+ * or pop moves a few of them across, the way an incremental
+ * hash table rehashes.
+ *
+ * Every element already has its slot in the new array. The
+ * slots iaLow up to iaHigh are still waiting in the old one:
+ *
+ *             iaLow        iaHigh
+ *   +---+---+---+---+---+---+---+---+
+ *   | A | B | ~ | ~ | E | F |   |   |   data
+ *   +---+---+---+---+---+---+---+---+
+ *               |   |
+ *     +---+---+---+---+
+ *     |   |   | C | D |                 dataOld
+ *     +---+---+---+---+
+ *
+ * Pushes land in the new array straight away. Elements only
+ * move when they migrate, which happens on push and pop and
+ * never on access.
+ *****************************************************/
+template <class T, size_t numStep, class Allocator>
+class deque <T, incremental<numStep>, Allocator>
+{
+   typedef std::allocator_traits<Allocator> alloc_traits;
+
+   // a migration step that throws would leave a push half done
+   static_assert(std::is_nothrow_move_constructible<T>::value,
+                 "incremental deque needs a nothrow move constructor");
+
+public:
+   typedef Allocator allocator_type;
+
+   //
+   // Construct
+   //
+
+   deque() : deque(Allocator()) { }
+   explicit deque(const Allocator & alloc)
+      : data(nullptr), numCapacity(0), numElements(0), iaFront(0),
+        dataOld(nullptr), numCapacityOld(0), iaFrontOld(0), iaLow(0), iaHigh(0),
+        alloc(alloc) { }
+   deque(size_t newCapacity, const Allocator & alloc = Allocator());
+   deque(const deque & rhs);
+   deque(deque && rhs) noexcept : deque(rhs.alloc)
+   {
+      takeArrays(rhs);
+   }
+   ~deque()
+   {
+      clear();
+      deallocate(data, numCapacity);
+   }
+
+   //
+   // Assign
+   //
+   deque & operator = (const deque & rhs);
+   deque & operator = (deque && rhs)
+      noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+               alloc_traits::is_always_equal::value);
+   void swap(deque & rhs) noexcept
+   {
+      // allocators that do not propagate must be equal to swap
+      assert(alloc_traits::propagate_on_container_swap::value || alloc == rhs.alloc);
+      std::swap(data,           rhs.data);
+      std::swap(numCapacity,    rhs.numCapacity);
+      std::swap(numElements,    rhs.numElements);
+      std::swap(iaFront,        rhs.iaFront);
+      std::swap(dataOld,        rhs.dataOld);
+      std::swap(numCapacityOld, rhs.numCapacityOld);
+      std::swap(iaFrontOld,     rhs.iaFrontOld);
+      std::swap(iaLow,          rhs.iaLow);
+      std::swap(iaHigh,         rhs.iaHigh);
+      propagateSwap(alloc, rhs.alloc,
+                    typename alloc_traits::propagate_on_container_swap());
+   }
+
+   //
+   // Iterator
+   //
+   class iterator;
+   iterator begin() { return iterator(this, 0); }
+   iterator end()   { return iterator(this, numElements); }
+
+   //
+   // Access
+   //
+   T & front()             { return *address(iaFront);                }
+   T & back()              { return *address(iaFromID(numElements - 1)); }
+   const T & front() const { return *address(iaFront);                }
+   const T & back()  const { return *address(iaFromID(numElements - 1)); }
+
+   const T & operator[](size_t index) const { return *address(iaFromID(index)); }
+         T & operator[](size_t index)       { return *address(iaFromID(index)); }
+
+   //
+   // Insert
+   //
+   void push_front(const T& t) { emplace_front(t);            }
+   void push_back(const T& t)  { emplace_back(t);             }
+   void push_front(T&& t)      { emplace_front(std::move(t)); }
+   void push_back(T&& t)       { emplace_back(std::move(t));  }
+   template <class ... Args>
+   T & emplace_front(Args && ... args);
+   template <class ... Args>
+   T & emplace_back(Args && ... args);
+
+   //
+   // Remove
+   //
+   void clear();
+   void pop_front();
+   void pop_back();
+   void pop_front(T & t);   // move the front element into t, then pop it
+   void pop_back(T & t);    // move the back element into t, then pop it
+
+   //
+   // Status
+   //
+   size_t size() const { return numElements; }
+   bool empty() const  { return numElements == 0; }
+   size_t capacity() const { return numCapacity; }
+   void reserve(size_t num);
+   Allocator get_allocator() const { return alloc; }
+
+#ifdef DEBUG // make this visible to the unit tests
+public:
+#else
+private:
+#endif
+
+   size_t iaFromID(size_t id) const
+   {
+      return capacity_any::wrap(iaFront + id, numCapacity);
+   }
+
+   // the element that belongs in slot ia, in whichever array it is now
+   T * address(size_t ia) const
+   {
+      if (ia - iaLow < iaHigh - iaLow)   // iaLow <= ia < iaHigh
+         return dataOld + capacity_any::wrap(iaFrontOld + ia, numCapacityOld);
+      return data + ia;
+   }
+
+   void grow();
+   void migrate(size_t num);
+   void releaseOld();
+   void takeArrays(deque & rhs);
+
+   T * allocate(size_t num)
+   {
+      return num ? alloc_traits::allocate(alloc, num) : nullptr;
+   }
+   void deallocate(T * p, size_t num)
+   {
+      if (p)
+         alloc_traits::deallocate(alloc, p, num);
+   }
+   void destroy(T * p)
+   {
+      if (!trivial_destroy<T, Allocator>::value)
+         alloc_traits::destroy(alloc, p);
+   }
+
+   // member variables
+   T * data;              // the array the elements are migrating to
+   size_t numCapacity;    // the size of data
+   size_t numElements;    // number of elements in the deque
+   size_t iaFront;        // the slot of the first item in data
+   T * dataOld;           // the array being emptied, nullptr when done
+   size_t numCapacityOld; // the size of dataOld
+   size_t iaFrontOld;     // slot ia of data is slot iaFrontOld + ia of dataOld
+   size_t iaLow;          // the first slot still in dataOld
+   size_t iaHigh;         // one past the last slot still in dataOld
+   Allocator alloc;       // where both arrays come from
+};
+
+/**********************************************************
+ * DEQUE ITERATOR : INCREMENTAL
+ *********************************************************/
+template <class T, size_t numStep, class Allocator>
+class deque <T, incremental<numStep>, Allocator> ::iterator
+{
+public:
+   //
+   // Construct
+   //
+   iterator() : id(0), pDeque(nullptr) { }
+   iterator(deque *pDeque, size_t id) : id(id), pDeque(pDeque) { }
+
+   //
+   // Compare
+   //
+   bool operator == (const iterator& rhs) const { return pDeque == rhs.pDeque && id == rhs.id; }
+   bool operator != (const iterator& rhs) const { return !(*this == rhs); }
+
+   //
+   // Access
+   //
+   const T & operator * () const { return (*pDeque)[id]; }
+   T & operator * ()             { return (*pDeque)[id]; }
+
+   //
+   // Arithmetic
+   //
+   std::ptrdiff_t operator - (iterator it) const
+   {
+      return (std::ptrdiff_t)id - (std::ptrdiff_t)it.id;
+   }
+   iterator& operator += (std::ptrdiff_t offset) { id += offset; return *this; }
+   iterator& operator ++ ()                      { id++; return *this;         }
+   iterator  operator ++ (int)                   { iterator i = *this; id++; return i; }
+   iterator& operator -- ()                      { id--; return *this;         }
+   iterator  operator -- (int)                   { iterator i = *this; id--; return i; }
+
+#ifdef DEBUG // make this visible to the unit tests
+public:
+#else
+private:
+#endif
+
+   // Member variables
+   size_t id;          // deque index
+   deque *pDeque;
+};
+
+/****************************************************
+ * DEQUE : INCREMENTAL : CONSTRUCTOR - non-default
+ ***************************************************/
+template <class T, size_t numStep, class Allocator>
+deque <T, incremental<numStep>, Allocator> :: deque(size_t newCapacity, const Allocator & alloc)
+   : deque(alloc)
+{
+   if (newCapacity > 0)
+   {
+      data = allocate(newCapacity);
+      numCapacity = newCapacity;
+   }
+}
+
+/****************************************************
+ * DEQUE : INCREMENTAL : CONSTRUCTOR - copy
+ ***************************************************/
+template <class T, size_t numStep, class Allocator>
+deque <T, incremental<numStep>, Allocator> :: deque(const deque & rhs)
+   : deque(alloc_traits::select_on_container_copy_construction(rhs.alloc))
+{
+   *this = rhs;
+}
+
+/****************************************************
+ * DEQUE : INCREMENTAL : ASSIGNMENT OPERATOR
+ * The copy is never mid-migration
+ ***************************************************/
+template <class T, size_t numStep, class Allocator>
+deque <T, incremental<numStep>, Allocator> &
+deque <T, incremental<numStep>, Allocator> :: operator = (const deque & rhs)
+{
+   if (this == &rhs)
+      return *this;
+
+   clear();
+   if (alloc_traits::propagate_on_container_copy_assignment::value && alloc != rhs.alloc)
+   {
+      // the array belongs to the old allocator
+      deallocate(data, numCapacity);
+      data = nullptr;
+      numCapacity = 0;
+   }
+   propagateCopy(alloc, rhs.alloc,
+                 typename alloc_traits::propagate_on_container_copy_assignment());
+   reserve(rhs.numElements);
+   for (size_t id = 0; id < rhs.numElements; id++)
+      emplace_back(rhs[id]);
+   return *this;
+}
+
+/****************************************************
+ * DEQUE : INCREMENTAL : ASSIGNMENT OPERATOR - move
+ * Take over both arrays when the allocators allow it.
+ * Otherwise the elements are moved one at a time.
+ ***************************************************/
+template <class T, size_t numStep, class Allocator>
+deque <T, incremental<numStep>, Allocator> &
+deque <T, incremental<numStep>, Allocator> :: operator = (deque && rhs)
+   noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+            alloc_traits::is_always_equal::value)
+{
+   if (this == &rhs)
+      return *this;
+
+   clear();
+   if (alloc_traits::propagate_on_container_move_assignment::value ||
+       alloc == rhs.alloc)
+   {
+      deallocate(data, numCapacity);
+      data = nullptr;
+      numCapacity = 0;
+      propagateMove(alloc, rhs.alloc,
+                    typename alloc_traits::propagate_on_container_move_assignment());
+      takeArrays(rhs);
+      return *this;
+   }
+
+   reserve(rhs.numElements);
+   for (size_t id = 0; id < rhs.numElements; id++)
+      emplace_back(std::move(rhs[id]));
+   rhs.clear();
+   return *this;
+}
+
+/****************************************************
+ * DEQUE : INCREMENTAL : TAKE ARRAYS
+ * Steal rhs's arrays, leaving rhs empty. Ours must
+ * already be gone.
+ ***************************************************/
+template <class T, size_t numStep, class Allocator>
+void deque <T, incremental<numStep>, Allocator> :: takeArrays(deque & rhs)
+{
+   data           = rhs.data;
+   numCapacity    = rhs.numCapacity;
+   numElements    = rhs.numElements;
+   iaFront        = rhs.iaFront;
+   dataOld        = rhs.dataOld;
+   numCapacityOld = rhs.numCapacityOld;
+   iaFrontOld     = rhs.iaFrontOld;
+   iaLow          = rhs.iaLow;
+   iaHigh         = rhs.iaHigh;
+   rhs.data = rhs.dataOld = nullptr;
+   rhs.numCapacity = rhs.numCapacityOld = 0;
+   rhs.numElements = rhs.iaFront = rhs.iaFrontOld = 0;
+   rhs.iaLow = rhs.iaHigh = 0;
+}
+
+/****************************************************
+ * DEQUE : INCREMENTAL : RESERVE
+ * An explicit reserve is allowed to pause, so it
+ * relocates everything at once and ends any migration
+ ***************************************************/
+template <class T, size_t numStep, class Allocator>
+void deque <T, incremental<numStep>, Allocator> :: reserve(size_t num)
+{
+   if (num <= numCapacity)
+      return;
+
+   T * newData = allocate(num);
+   for (size_t id = 0; id < numElements; id++)
+   {
+      T * p = address(iaFromID(id));
+      alloc_traits::construct(alloc, newData + id, std::move(*p));
+      destroy(p);
+   }
+   deallocate(data, numCapacity);
+   releaseOld();
+
+   data = newData;
+   numCapacity = num;
+   iaFront = 0;
+}
+
+/****************************************************
+ * DEQUE : INCREMENTAL : GROW
+ * Allocate the doubled array and start a migration. No
+ * element moves here. Every push migrates at least one
+ * element, so the last migration is always over by the
+ * time the new array is full.
+ ***************************************************/
+template <class T, size_t numStep, class Allocator>
+void deque <T, incremental<numStep>, Allocator> :: grow()
+{
+   assert(dataOld == nullptr);
+   size_t numNew = capacity_any::grow(numCapacity);
+   T * newData = allocate(numNew);
+
+   if (numElements)
+   {
+      dataOld        = data;
+      numCapacityOld = numCapacity;
+      iaFrontOld     = iaFront;
+      iaLow          = 0;
+      iaHigh         = numElements;
+   }
+   else
+      deallocate(data, numCapacity);
+
+   data = newData;
+   numCapacity = numNew;
+   iaFront = 0;
+}
+
+/****************************************************
+ * DEQUE : INCREMENTAL : MIGRATE
+ * Move up to num elements from the old array to their
+ * slots in the new one, and free the old array once it
+ * is empty
+ ***************************************************/
+template <class T, size_t numStep, class Allocator>
+void deque <T, incremental<numStep>, Allocator> :: migrate(size_t num)
+{
+   for (; num && iaLow < iaHigh; num--, iaLow++)
+   {
+      T * p = address(iaLow);
+      alloc_traits::construct(alloc, data + iaLow, std::move(*p));
+      destroy(p);
+   }
+   if (dataOld && iaLow == iaHigh)
+      releaseOld();
+}
+
+/****************************************************
+ * DEQUE : INCREMENTAL : RELEASE OLD
+ * Free the old array. It must hold no elements.
+ ***************************************************/
+template <class T, size_t numStep, class Allocator>
+void deque <T, incremental<numStep>, Allocator> :: releaseOld()
+{
+   deallocate(dataOld, numCapacityOld);
+   dataOld = nullptr;
+   numCapacityOld = 0;
+   iaFrontOld = 0;
+   iaLow = iaHigh = 0;
+}
+
+/******************************************************
+ * DEQUE : INCREMENTAL : EMPLACE_BACK
+ * Nothing moves before the new element is constructed,
+ * so args may still refer to one of our own elements
+ ******************************************************/
+template <class T, size_t numStep, class Allocator>
+template <class ... Args>
+T & deque <T, incremental<numStep>, Allocator> :: emplace_back(Args && ... args)
+{
+   if (numElements == numCapacity)
+      grow();
+   T * p = data + iaFromID(numElements);
+   alloc_traits::construct(alloc, p, std::forward<Args>(args)...);
+   numElements++;
+   migrate(numStep);
+   return *p;
+}
+
+/******************************************************
+ * DEQUE : INCREMENTAL : EMPLACE_FRONT
+ ******************************************************/
+template <class T, size_t numStep, class Allocator>
+template <class ... Args>
+T & deque <T, incremental<numStep>, Allocator> :: emplace_front(Args && ... args)
+{
+   if (numElements == numCapacity)
+      grow();
+   size_t iaNew = capacity_any::wrap(iaFront + numCapacity - 1, numCapacity);
+   T * p = data + iaNew;
+   alloc_traits::construct(alloc, p, std::forward<Args>(args)...);
+   iaFront = iaNew;
+   numElements++;
+   migrate(numStep);
+   return *p;
+}
+
+/*****************************************************
+ * DEQUE : INCREMENTAL : POP_BACK
+ * A back element still in the old array is the last
+ * one waiting there
+ *****************************************************/
+template <class T, size_t numStep, class Allocator>
+void deque <T, incremental<numStep>, Allocator> :: pop_back()
+{
+   size_t ia = iaFromID(--numElements);
+   destroy(address(ia));
+   if (iaLow < iaHigh && ia == iaHigh - 1)
+      iaHigh--;
+   migrate(numStep);
+}
+
+/*****************************************************
+ * DEQUE : INCREMENTAL : POP_FRONT
+ * A front element still in the old array is the first
+ * one waiting there
+ *****************************************************/
+template <class T, size_t numStep, class Allocator>
+void deque <T, incremental<numStep>, Allocator> :: pop_front()
+{
+   destroy(address(iaFront));
+   if (iaLow < iaHigh && iaFront == iaLow)
+      iaLow++;
+   iaFront = iaFromID(1);
+   numElements--;
+   migrate(numStep);
+}
+
+/*****************************************************
+ * DEQUE : INCREMENTAL : POP - move out
+ *****************************************************/
+template <class T, size_t numStep, class Allocator>
+void deque <T, incremental<numStep>, Allocator> :: pop_back(T & t)
+{
+   t = std::move(back());
+   pop_back();
+}
+template <class T, size_t numStep, class Allocator>
+void deque <T, incremental<numStep>, Allocator> :: pop_front(T & t)
+{
+   t = std::move(front());
+   pop_front();
+}
+
+/*****************************************************
+ * DEQUE : INCREMENTAL : CLEAR
+ * Destroy every element wherever it is, and drop the
+ * old array. The new array is kept.
+ *****************************************************/
+template <class T, size_t numStep, class Allocator>
+void deque <T, incremental<numStep>, Allocator> :: clear()
+{
+   if (!trivial_destroy<T, Allocator>::value)
+      for (size_t id = 0; id < numElements; id++)
+         destroy(address(iaFromID(id)));
+   releaseOld();
+   numElements = 0;
+   iaFront = 0;
+}
+
+/******************************************************
+ * SWAP : INCREMENTAL
+ ******************************************************/
+template <class T, size_t numStep, class Allocator>
+void swap(deque <T, incremental<numStep>, Allocator> & lhs,
+          deque <T, incremental<numStep>, Allocator> & rhs) noexcept
+{
+   lhs.swap(rhs);
+}
+
+} // namespace custom
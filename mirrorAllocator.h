@@ -0,0 +1,164 @@
+/***********************************************************************
+ * Header:
+ *    MIRROR ALLOCATOR
+ * Summary:
+ *    The "magic ring buffer": each array is mapped twice, back to
+ *    back, so the slots just past the end are the slots at the
+ *    beginning again. A deque on this storage never has to wrap:
+ *
+ *        custom::deque<int, custom::capacity_mirror,
+ *                      custom::mirror_allocator<int>> d;
+ *        std::memcpy(out, d.contiguous(), d.size() * sizeof(int));
+ *
+ *    Linux only. Elsewhere DEQUE_MIRROR is not defined and the
+ *    header is empty.
+ *
+ *    This will contain the class definition of:
+ *        mirror_allocator      : arrays mapped twice in a row
+ *        capacity_mirror       : capacity policy for a mirrored deque
+ * Author
+ *    Alexander Dohms, Stephen Costigan, Shaun Crook, Jonathan Colwell
+ ************************************************************************/
+
+#pragma once
+
+#ifdef __linux__
+#ifndef DEQUE_MIRROR
+#define DEQUE_MIRROR         // memfd_create is a Linux system call
+#endif
+
+#include "deque.h"           // for capacity_any, fitsAllocator
+#include <cstddef>           // for size_t
+#include <new>               // for std::bad_alloc
+#include <sys/mman.h>        // for mmap, munmap, memfd_create
+#include <unistd.h>          // for ftruncate, close, sysconf
+
+namespace custom
+{
+
+/******************************************************
+ * MIRROR ALLOCATOR
+ * An array of n bytes is a memory file mapped at p and
+ * again at p + n:
+ *
+ *        p                   p + n
+ *      +---+---+---+---+   +---+---+---+---+
+ *      | A | B | C | D |   | A | B | C | D |
+ *      +---+---+---+---+   +---+---+---+---+
+ *          \___________________/
+ *           one run, from B to A
+ *
+ * n must be a whole number of pages and of elements, so
+ * requests are rounded up. allocate_at_least() reports
+ * how many elements that came to. The deque needs exactly
+ * that count as its capacity.
+ *****************************************************/
+template <class T>
+class mirror_allocator
+{
+public:
+   typedef T value_type;
+   typedef std::true_type is_always_equal;
+
+   struct allocation_result
+   {
+      T * ptr;
+      size_t count;
+   };
+
+   mirror_allocator() noexcept { }
+   template <class U>
+   mirror_allocator(const mirror_allocator<U> &) noexcept { }
+
+   allocation_result allocate_at_least(size_t num)
+   {
+      size_t numBytes = roundBytes(num);
+
+      int fd = memfd_create("custom::deque", MFD_CLOEXEC);
+      if (fd == -1)
+         throw std::bad_alloc();
+      if (ftruncate(fd, numBytes) == -1)
+      {
+         close(fd);
+         throw std::bad_alloc();
+      }
+
+      // reserve both halves, then lay the file over each
+      char * p = static_cast<char *>(mmap(nullptr, 2 * numBytes, PROT_NONE,
+                                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+      bool mapped = p != MAP_FAILED &&
+         mmap(p,            numBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED &&
+         mmap(p + numBytes, numBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+      close(fd);   // the mappings keep the file alive
+      if (!mapped)
+      {
+         if (p != MAP_FAILED)
+            munmap(p, 2 * numBytes);
+         throw std::bad_alloc();
+      }
+      return { reinterpret_cast<T *>(p), numBytes / sizeof(T) };
+   }
+   T * allocate(size_t num)
+   {
+      return allocate_at_least(num).ptr;
+   }
+   void deallocate(T * p, size_t num)
+   {
+      munmap(p, 2 * roundBytes(num));
+   }
+
+   template <class U>
+   bool operator == (const mirror_allocator<U> &) const { return true;  }
+   template <class U>
+   bool operator != (const mirror_allocator<U> &) const { return false; }
+
+#ifdef DEBUG // make this visible to the unit tests
+public:
+#else
+private:
+#endif
+
+   // bytes for num elements, rounded up to pages that hold whole elements
+   static size_t roundBytes(size_t num)
+   {
+      static const size_t numUnit = unitBytes();
+      if (num == 0)
+         num = 1;
+      if (num > ((size_t)-1 / 2 - numUnit) / sizeof(T))
+         throw std::bad_alloc();
+      return (num * sizeof(T) + numUnit - 1) / numUnit * numUnit;
+   }
+
+   // the least common multiple of the page size and sizeof(T)
+   static size_t unitBytes()
+   {
+      size_t numPage = (size_t)sysconf(_SC_PAGESIZE);
+      size_t a = numPage;
+      size_t b = sizeof(T);
+      while (b)
+      {
+         size_t r = a % b;
+         a = b;
+         b = r;
+      }
+      return numPage / a * sizeof(T);
+   }
+};
+
+/******************************************************
+ * CAPACITY MIRROR
+ * Grows like capacity_any, keeps the capacity that
+ * mirror_allocator hands back, and tells the deque it
+ * can index past the end without folding.
+ *****************************************************/
+struct capacity_mirror : capacity_any
+{
+   static const bool mirrored = true;
+};
+
+template <>
+struct fitsAllocator <capacity_mirror> : std::true_type { };
+
+} // namespace custom
+
+#endif // __linux__
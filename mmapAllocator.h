@@ -0,0 +1,121 @@
+/***********************************************************************
+ * Header:
+ *    MMAP ALLOCATOR
+ * Summary:
+ *    An allocator that puts big arrays straight into anonymous
+ *    mappings, so that a deque of trivially copyable elements can
+ *    grow them with mremap instead of copying:
+ *
+ *        custom::deque<int, custom::capacity_any,
+ *                      custom::mmap_allocator<int>> d;
+ *
+ *    Linux only. Elsewhere DEQUE_MREMAP is not defined and the
+ *    header is empty.
+ *
+ *    This will contain the class definition of:
+ *        mmap_allocator        : small arrays on the heap, big ones mapped
+ * Author
+ *    Alexander Dohms, Stephen Costigan, Shaun Crook, Jonathan Colwell
+ ************************************************************************/
+
+#pragma once
+
+#ifdef __linux__
+#ifndef DEQUE_MREMAP
+#define DEQUE_MREMAP         // mremap is a Linux system call
+#endif
+
+#include <cstddef>           // for size_t
+#include <new>               // for ::operator new, std::bad_alloc
+#include <type_traits>       // for std::true_type
+#include <sys/mman.h>        // for mmap, mremap, munmap
+#include <unistd.h>          // for sysconf
+
+namespace custom
+{
+
+/******************************************************
+ * MMAP ALLOCATOR
+ * Arrays of numThreshold bytes or more get their own
+ * mapping, rounded up to whole pages. Smaller ones come
+ * from ::operator new, where a mapping would waste most
+ * of a page.
+ *
+ * reallocate() resizes a mapping in place, or lets the
+ * kernel move its pages somewhere else. Either way no
+ * byte is copied. It returns nullptr when either size is
+ * under the threshold, and the caller copies as usual.
+ *****************************************************/
+template <class T, size_t numThreshold = 1 << 16>
+class mmap_allocator
+{
+public:
+   typedef T value_type;
+   typedef std::true_type is_always_equal;
+   template <class U>
+   struct rebind { typedef mmap_allocator<U, numThreshold> other; };
+
+   mmap_allocator() noexcept { }
+   template <class U>
+   mmap_allocator(const mmap_allocator<U, numThreshold> &) noexcept { }
+
+   T * allocate(size_t num)
+   {
+      if (num > (size_t)-1 / sizeof(T))
+         throw std::bad_alloc();
+      size_t numBytes = num * sizeof(T);
+      if (numBytes < numThreshold)
+         return static_cast<T *>(::operator new(numBytes));
+
+      void * p = mmap(nullptr, pageRound(numBytes), PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (p == MAP_FAILED)
+         throw std::bad_alloc();
+      return static_cast<T *>(p);
+   }
+
+   void deallocate(T * p, size_t num)
+   {
+      size_t numBytes = num * sizeof(T);
+      if (numBytes < numThreshold)
+         ::operator delete(p);
+      else
+         munmap(p, pageRound(numBytes));
+   }
+
+   // grow or shrink a mapped array without copying it
+   T * reallocate(T * p, size_t numOld, size_t numNew)
+   {
+      if (numNew > (size_t)-1 / sizeof(T))
+         throw std::bad_alloc();
+      if (numOld * sizeof(T) < numThreshold || numNew * sizeof(T) < numThreshold)
+         return nullptr;
+
+      void * pNew = mremap(p, pageRound(numOld * sizeof(T)),
+                           pageRound(numNew * sizeof(T)), MREMAP_MAYMOVE);
+      if (pNew == MAP_FAILED)
+         throw std::bad_alloc();
+      return static_cast<T *>(pNew);
+   }
+
+   template <class U>
+   bool operator == (const mmap_allocator<U, numThreshold> &) const { return true;  }
+   template <class U>
+   bool operator != (const mmap_allocator<U, numThreshold> &) const { return false; }
+
+#ifdef DEBUG // make this visible to the unit tests
+public:
+#else
+private:
+#endif
+
+   static size_t pageRound(size_t numBytes)
+   {
+      static const size_t numPage = (size_t)sysconf(_SC_PAGESIZE);
+      return (numBytes + numPage - 1) / numPage * numPage;
+   }
+};
+
+} // namespace custom
+
+#endif // __linux__
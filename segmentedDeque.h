@@ -0,0 +1,535 @@
+/***********************************************************************
+ * Header:
+ *    SEGMENTED DEQUE
+ * Summary:
+ *    The block-map storage engine for custom::deque. Selected with
+ *    the second template parameter:
+ *
+ *        custom::deque<T, custom::segmented<64>>
+ *
+ *    This will contain the class definition of:
+ *        segmented             : tag selecting the engine and block size
+ *        deque<T, segmented>   : a deque made of fixed-size blocks
+ *        deque::iterator       : An iterator through the deque
+ * Author
+ *    Alexander Dohms, Stephen Costigan, Shaun Crook, Jonathan Colwell
+ ************************************************************************/
+
+#pragma once
+
+#include "deque.h"   // for the primary deque template
+
+namespace custom
+{
+
+// number of bits to shift to divide by a power of two
+constexpr size_t floorLog2(size_t num)
+{
+   return num <= 1 ? 0 : 1 + floorLog2(num >> 1);
+}
+
+/******************************************************
+ * SEGMENTED
+ * Storage engine tag. numBlock elements live in each
+ * block and must be a power of two.
+ *****************************************************/
+template <size_t numBlock = 64>
+struct segmented
+{
+   static_assert(numBlock && (numBlock & (numBlock - 1)) == 0,
+                 "segmented block size must be a power of two");
+   static const size_t size  = numBlock;
+   static const size_t shift = floorLog2(numBlock);
+};
+
+/******************************************************
+ * DEQUE : SEGMENTED
+ * Elements live in fixed-size blocks. A central map holds
+ * a pointer to every block, and a slot number s names
+ * block s / numBlock, offset s % numBlock:
+ *
+ *            map
+ *      +----+----+----+----+
+ *      |    | *  | *  |    |
+ *      +----+-|--+-|--+----+
+ *             |    |
+ *             |    +-> +---+---+---+---+
+ *             |        | C | D |   |   |
+ *             |        +---+---+---+---+
+ *             +------> +---+---+---+---+
+ *                      |   |   | A | B |
+ *                      +---+---+---+---+
+ * iaFront = 6 (block 1, offset 2), numElements = 4
+ *
+ * Growing at either end allocates one block and, rarely,
+ * copies the block pointers into a bigger map. Elements are
+ * never relocated, so references survive every push.
+ *****************************************************/
+template <class T, size_t numBlock, class Allocator>
+class deque <T, segmented<numBlock>, Allocator>
+{
+   typedef std::allocator_traits<Allocator> alloc_traits;
+   typedef typename alloc_traits::template rebind_alloc<T *> map_allocator;
+   typedef std::allocator_traits<map_allocator> map_traits;
+
+public:
+   typedef Allocator allocator_type;
+
+   //
+   // Construct
+   //
+
+   deque() : map(nullptr), numMap(0), numElements(0), iaFront(0), alloc() { }
+   explicit deque(const Allocator & alloc)
+      : map(nullptr), numMap(0), numElements(0), iaFront(0), alloc(alloc) { }
+   deque(size_t newCapacity, const Allocator & alloc = Allocator());
+   deque(const deque & rhs);
+   deque(deque && rhs) noexcept
+      : map(rhs.map), numMap(rhs.numMap),
+        numElements(rhs.numElements), iaFront(rhs.iaFront),
+        alloc(std::move(rhs.alloc))
+   {
+      rhs.map = nullptr;
+      rhs.numMap = 0;
+      rhs.numElements = 0;
+      rhs.iaFront = 0;
+   }
+   ~deque()
+   {
+      clear();
+      deallocateMap(map, numMap);
+   }
+
+   //
+   // Assign
+   //
+   deque & operator = (const deque & rhs);
+   deque & operator = (deque && rhs)
+      noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+               alloc_traits::is_always_equal::value);
+   void swap(deque & rhs) noexcept
+   {
+      // allocators that do not propagate must be equal to swap
+      assert(alloc_traits::propagate_on_container_swap::value || alloc == rhs.alloc);
+      std::swap(map,         rhs.map);
+      std::swap(numMap,      rhs.numMap);
+      std::swap(numElements, rhs.numElements);
+      std::swap(iaFront,     rhs.iaFront);
+      propagateSwap(alloc, rhs.alloc,
+                    typename alloc_traits::propagate_on_container_swap());
+   }
+
+   //
+   // Iterator
+   //
+   class iterator;
+   iterator begin() { return iterator(this, 0); }
+   iterator end()   { return iterator(this, numElements); }
+
+   //
+   // Access
+   //
+   T & front()             { return slot(iaFront);                   }
+   T & back()              { return slot(iaFront + numElements - 1); }
+   const T & front() const { return slot(iaFront);                   }
+   const T & back()  const { return slot(iaFront + numElements - 1); }
+
+   const T & operator[](size_t index) const { return slot(iaFront + index); }
+         T & operator[](size_t index)       { return slot(iaFront + index); }
+
+   //
+   // Insert
+   //
+   void push_front(const T& t) { emplace_front(t);            }
+   void push_back(const T& t)  { emplace_back(t);             }
+   void push_front(T&& t)      { emplace_front(std::move(t)); }
+   void push_back(T&& t)       { emplace_back(std::move(t));  }
+   template <class ... Args>
+   T & emplace_front(Args && ... args);
+   template <class ... Args>
+   T & emplace_back(Args && ... args);
+
+   //
+   // Remove
+   //
+   void clear();
+   void pop_front();
+   void pop_back();
+   void pop_front(T & t);   // move the front element into t, then pop it
+   void pop_back(T & t);    // move the back element into t, then pop it
+
+   //
+   // Status
+   //
+   size_t size() const { return numElements; }
+   bool empty() const  { return numElements == 0; }
+   Allocator get_allocator() const { return alloc; }
+
+#ifdef DEBUG // make this visible to the unit tests
+public:
+#else
+private:
+#endif
+
+   static const size_t shift = segmented<numBlock>::shift;
+   static const size_t mask  = numBlock - 1;
+
+   // fetch the element in slot s: one shift and one mask
+   T & slot(size_t s) const
+   {
+      return map[s >> shift][s & mask];
+   }
+
+   // make sure block iBlock exists
+   void reserveBlock(size_t iBlock);
+   void growMap(size_t numFront, size_t numBack);
+
+   // the map and the blocks both come from alloc
+   T * allocateBlock()
+   {
+      return alloc_traits::allocate(alloc, numBlock);
+   }
+   void deallocateBlock(T * p)
+   {
+      alloc_traits::deallocate(alloc, p, numBlock);
+   }
+   T ** allocateMap(size_t num)
+   {
+      map_allocator mapAlloc(alloc);
+      T ** p = map_traits::allocate(mapAlloc, num);
+      for (size_t i = 0; i < num; i++)
+         p[i] = nullptr;
+      return p;
+   }
+   void deallocateMap(T ** p, size_t num)
+   {
+      map_allocator mapAlloc(alloc);
+      if (p)
+         map_traits::deallocate(mapAlloc, p, num);
+   }
+   void releaseAll()
+   {
+      clear();
+      deallocateMap(map, numMap);
+      map = nullptr;
+      numMap = 0;
+   }
+
+   // member variables
+   T ** map;           // one pointer per block, nullptr if not allocated
+   size_t numMap;      // the number of pointers in map
+   size_t numElements; // number of elements in the deque
+   size_t iaFront;     // the slot of the first item, counted from map[0]
+   Allocator alloc;    // where the map and the blocks come from
+};
+
+/**********************************************************
+ * DEQUE ITERATOR : SEGMENTED
+ *********************************************************/
+template <class T, size_t numBlock, class Allocator>
+class deque <T, segmented<numBlock>, Allocator> ::iterator
+{
+public:
+   //
+   // Construct
+   //
+   iterator() : id(0), pDeque(nullptr) { }
+   iterator(deque *pDeque, size_t id) : id(id), pDeque(pDeque) { }
+
+   //
+   // Compare
+   //
+   bool operator == (const iterator& rhs) const { return pDeque == rhs.pDeque && id == rhs.id; }
+   bool operator != (const iterator& rhs) const { return !(*this == rhs); }
+
+   //
+   // Access
+   //
+   const T & operator * () const { return (*pDeque)[id]; }
+   T & operator * ()             { return (*pDeque)[id]; }
+
+   //
+   // Arithmetic
+   //
+   std::ptrdiff_t operator - (iterator it) const
+   {
+      return (std::ptrdiff_t)id - (std::ptrdiff_t)it.id;
+   }
+   iterator& operator += (std::ptrdiff_t offset) { id += offset; return *this; }
+   iterator& operator ++ ()                      { id++; return *this;         }
+   iterator  operator ++ (int)                   { iterator i = *this; id++; return i; }
+   iterator& operator -- ()                      { id--; return *this;         }
+   iterator  operator -- (int)                   { iterator i = *this; id--; return i; }
+
+#ifdef DEBUG // make this visible to the unit tests
+public:
+#else
+private:
+#endif
+
+   // Member variables
+   size_t id;          // deque index
+   deque *pDeque;
+};
+
+/****************************************************
+ * DEQUE : SEGMENTED : CONSTRUCTOR - non-default
+ * Size the map for newCapacity elements so the first
+ * pushes never have to grow it
+ ***************************************************/
+template <class T, size_t numBlock, class Allocator>
+deque <T, segmented<numBlock>, Allocator> :: deque(size_t newCapacity, const Allocator & alloc)
+   : map(nullptr), numMap(0), numElements(0), iaFront(0), alloc(alloc)
+{
+   if (newCapacity > 0)
+      growMap(0, (newCapacity + mask) >> shift);
+}
+
+/****************************************************
+ * DEQUE : SEGMENTED : CONSTRUCTOR - copy
+ ***************************************************/
+template <class T, size_t numBlock, class Allocator>
+deque <T, segmented<numBlock>, Allocator> :: deque(const deque & rhs)
+   : map(nullptr), numMap(0), numElements(0), iaFront(0),
+     alloc(alloc_traits::select_on_container_copy_construction(rhs.alloc))
+{
+   *this = rhs;
+}
+
+/****************************************************
+ * DEQUE : SEGMENTED : ASSIGNMENT OPERATOR
+ ***************************************************/
+template <class T, size_t numBlock, class Allocator>
+deque <T, segmented<numBlock>, Allocator> &
+deque <T, segmented<numBlock>, Allocator> :: operator = (const deque & rhs)
+{
+   if (this != &rhs)
+   {
+      if (alloc_traits::propagate_on_container_copy_assignment::value)
+      {
+         // the blocks and the map belong to the old allocator
+         if (alloc != rhs.alloc)
+            releaseAll();
+         propagateCopy(alloc, rhs.alloc,
+                       typename alloc_traits::propagate_on_container_copy_assignment());
+      }
+      clear();
+      for (size_t id = 0; id < rhs.numElements; id++)
+         emplace_back(rhs[id]);
+   }
+   return *this;
+}
+
+/****************************************************
+ * DEQUE : SEGMENTED : ASSIGNMENT OPERATOR - move
+ * Take over the map when the allocators allow it.
+ * Otherwise the elements are moved one at a time.
+ ***************************************************/
+template <class T, size_t numBlock, class Allocator>
+deque <T, segmented<numBlock>, Allocator> &
+deque <T, segmented<numBlock>, Allocator> :: operator = (deque && rhs)
+   noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+            alloc_traits::is_always_equal::value)
+{
+   if (this == &rhs)
+      return *this;
+
+   if (alloc_traits::propagate_on_container_move_assignment::value ||
+       alloc == rhs.alloc)
+   {
+      releaseAll();
+      propagateMove(alloc, rhs.alloc,
+                    typename alloc_traits::propagate_on_container_move_assignment());
+      map         = rhs.map;
+      numMap      = rhs.numMap;
+      numElements = rhs.numElements;
+      iaFront     = rhs.iaFront;
+      rhs.map = nullptr;
+      rhs.numMap = 0;
+      rhs.numElements = 0;
+      rhs.iaFront = 0;
+      return *this;
+   }
+
+   clear();
+   for (size_t id = 0; id < rhs.numElements; id++)
+      emplace_back(std::move(rhs[id]));
+   rhs.clear();
+   return *this;
+}
+
+/****************************************************
+ * DEQUE : SEGMENTED : GROW MAP
+ * Make a map with at least numFront free block pointers
+ * before the first block in use and numBack after the
+ * last one. Only the block pointers are copied.
+ ***************************************************/
+template <class T, size_t numBlock, class Allocator>
+void deque <T, segmented<numBlock>, Allocator> :: growMap(size_t numFront, size_t numBack)
+{
+   // the blocks currently allocated
+   size_t iFirst = 0;
+   size_t iLast = 0;
+   while (iFirst < numMap && map[iFirst] == nullptr)
+      iFirst++;
+   for (iLast = numMap; iLast > iFirst && map[iLast - 1] == nullptr; iLast--)
+      ;
+   size_t numUsed = iLast - iFirst;
+
+   // double the map so repeated growth at one end stays O(1) amortized
+   size_t numNew = numMap * 2;
+   if (numNew < numUsed + numFront + numBack)
+      numNew = numUsed + numFront + numBack;
+   if (numNew < 8)
+      numNew = 8;
+
+   // center the blocks in use, honoring the requested room
+   size_t iNew = (numNew - numUsed) / 2;
+   if (iNew < numFront)
+      iNew = numFront;
+   if (iNew + numUsed + numBack > numNew)
+      iNew = numNew - numUsed - numBack;
+
+   T ** mapNew = allocateMap(numNew);
+   for (size_t i = 0; i < numUsed; i++)
+      mapNew[iNew + i] = map[iFirst + i];
+
+   // slot numbers are counted from map[0], so shift iaFront with the blocks
+   if (numUsed)
+      iaFront = iaFront - (iFirst << shift) + (iNew << shift);
+   else
+      iaFront = iNew << shift;
+
+   deallocateMap(map, numMap);
+   map = mapNew;
+   numMap = numNew;
+}
+
+/****************************************************
+ * DEQUE : SEGMENTED : RESERVE BLOCK
+ ***************************************************/
+template <class T, size_t numBlock, class Allocator>
+void deque <T, segmented<numBlock>, Allocator> :: reserveBlock(size_t iBlock)
+{
+   if (map[iBlock] == nullptr)
+      map[iBlock] = allocateBlock();
+}
+
+/******************************************************
+ * DEQUE : SEGMENTED : EMPLACE_BACK
+ ******************************************************/
+template <class T, size_t numBlock, class Allocator>
+template <class ... Args>
+T & deque <T, segmented<numBlock>, Allocator> :: emplace_back(Args && ... args)
+{
+   if (numMap == 0 || ((iaFront + numElements) >> shift) >= numMap)
+      growMap(0, 1);
+   size_t s = iaFront + numElements;
+   reserveBlock(s >> shift);
+   T * p = &slot(s);
+   alloc_traits::construct(alloc, p, std::forward<Args>(args)...);
+   numElements++;
+   return *p;
+}
+
+/******************************************************
+ * DEQUE : SEGMENTED : EMPLACE_FRONT
+ ******************************************************/
+template <class T, size_t numBlock, class Allocator>
+template <class ... Args>
+T & deque <T, segmented<numBlock>, Allocator> :: emplace_front(Args && ... args)
+{
+   if (numMap == 0 || iaFront == 0)
+      growMap(1, 0);
+   size_t s = iaFront - 1;
+   reserveBlock(s >> shift);
+   T * p = &slot(s);
+   alloc_traits::construct(alloc, p, std::forward<Args>(args)...);
+   iaFront = s;
+   numElements++;
+   return *p;
+}
+
+/*****************************************************
+ * DEQUE : SEGMENTED : POP_BACK
+ * Release the last block once its last element is gone.
+ * The block holding iaFront is kept so an emptied deque
+ * can be refilled without an allocation.
+ *****************************************************/
+template <class T, size_t numBlock, class Allocator>
+void deque <T, segmented<numBlock>, Allocator> :: pop_back()
+{
+   size_t s = iaFront + --numElements;
+   alloc_traits::destroy(alloc, &slot(s));
+   if ((s & mask) == 0 && s != iaFront)
+   {
+      deallocateBlock(map[s >> shift]);
+      map[s >> shift] = nullptr;
+   }
+}
+
+/*****************************************************
+ * DEQUE : SEGMENTED : POP_FRONT
+ * Release the first block once its last element is gone
+ *****************************************************/
+template <class T, size_t numBlock, class Allocator>
+void deque <T, segmented<numBlock>, Allocator> :: pop_front()
+{
+   alloc_traits::destroy(alloc, &slot(iaFront));
+   iaFront++;
+   numElements--;
+   if ((iaFront & mask) == 0)
+   {
+      deallocateBlock(map[(iaFront - 1) >> shift]);
+      map[(iaFront - 1) >> shift] = nullptr;
+   }
+}
+
+/*****************************************************
+ * DEQUE : SEGMENTED : POP - move out
+ *****************************************************/
+template <class T, size_t numBlock, class Allocator>
+void deque <T, segmented<numBlock>, Allocator> :: pop_back(T & t)
+{
+   t = std::move(back());
+   pop_back();
+}
+template <class T, size_t numBlock, class Allocator>
+void deque <T, segmented<numBlock>, Allocator> :: pop_front(T & t)
+{
+   t = std::move(front());
+   pop_front();
+}
+
+/*****************************************************
+ * DEQUE : SEGMENTED : CLEAR
+ * Destroy every element and release every block. The map
+ * is kept, and the front moves back to its middle.
+ *****************************************************/
+template <class T, size_t numBlock, class Allocator>
+void deque <T, segmented<numBlock>, Allocator> :: clear()
+{
+   if (!trivial_destroy<T, Allocator>::value)
+      for (size_t id = 0; id < numElements; id++)
+         alloc_traits::destroy(alloc, &slot(iaFront + id));
+   for (size_t i = 0; i < numMap; i++)
+      if (map[i])
+      {
+         deallocateBlock(map[i]);
+         map[i] = nullptr;
+      }
+   numElements = 0;
+   iaFront = (numMap / 2) << shift;
+}
+
+/******************************************************
+ * SWAP : SEGMENTED
+ ******************************************************/
+template <class T, size_t numBlock, class Allocator>
+void swap(deque <T, segmented<numBlock>, Allocator> & lhs,
+          deque <T, segmented<numBlock>, Allocator> & rhs) noexcept
+{
+   lhs.swap(rhs);
+}
+
+} // namespace custom
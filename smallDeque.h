@@ -0,0 +1,543 @@
+/***********************************************************************
+ * Header:
+ *    SMALL DEQUE
+ * Summary:
+ *    The inline-storage engine for custom::deque. Up to numInline
+ *    elements live inside the deque object itself, and only a deque
+ *    that outgrows them allocates:
+ *
+ *        custom::small_deque<int, 8> d;   // deque<int, small_buffer<8>>
+ *
+ *    This will contain the class definition of:
+ *        small_buffer          : tag selecting the engine and inline size
+ *        deque<T, small_buffer> : a ring that starts in the object
+ *        deque::iterator       : An iterator through the deque
+ *        small_deque           : shorthand for deque<T, small_buffer<N>>
+ * Author
+ *    Alexander Dohms, Stephen Costigan, Shaun Crook, Jonathan Colwell
+ ************************************************************************/
+
+#pragma once
+
+#include "deque.h"   // for the primary deque template
+
+namespace custom
+{
+
+/******************************************************
+ * SMALL BUFFER
+ * Storage engine tag. numInline elements fit in the
+ * deque before it goes to the allocator.
+ *****************************************************/
+template <size_t numInline = 8>
+struct small_buffer
+{
+   static_assert(numInline > 0, "small_buffer needs room for at least one element");
+   static const size_t size = numInline;
+};
+
+/******************************************************
+ * DEQUE : SMALL
+ * The same ring as the primary deque. The array starts
+ * out as the buffer inside the object:
+ *
+ *      deque
+ *    +--------------------------------------+
+ *    | data ----+                           |
+ *    |          v                           |
+ *    | buffer [ C | D |   | A | B ]         |
+ *    +--------------------------------------+
+ *
+ * When it fills, the ring moves to an allocated array of
+ * twice the size and the buffer sits unused until
+ * shrink_to_fit() or a move brings the elements back.
+ *****************************************************/
+template <class T, size_t numInline, class Allocator>
+class deque <T, small_buffer<numInline>, Allocator>
+{
+   typedef std::allocator_traits<Allocator> alloc_traits;
+
+public:
+   typedef Allocator allocator_type;
+
+   //
+   // Construct
+   //
+
+   deque() : deque(Allocator()) { }
+   explicit deque(const Allocator & alloc)
+      : data(inlineData()), numCapacity(numInline), numElements(0), iaFront(0),
+        alloc(alloc) { }
+   deque(size_t newCapacity, const Allocator & alloc = Allocator())
+      : deque(alloc)
+   {
+      if (newCapacity > 0)
+         reserve(newCapacity);
+   }
+   deque(const deque & rhs)
+      : deque(alloc_traits::select_on_container_copy_construction(rhs.alloc))
+   {
+      *this = rhs;
+   }
+   deque(deque && rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+      : deque(rhs.alloc)
+   {
+      takeElements(rhs);
+   }
+   ~deque()
+   {
+      clear();
+      deallocate(data, numCapacity);
+   }
+
+   //
+   // Assign
+   //
+   deque & operator = (const deque & rhs);
+   deque & operator = (deque && rhs);
+   void swap(deque & rhs) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+   //
+   // Iterator
+   //
+   class iterator;
+   iterator begin() { return iterator(this, 0); }
+   iterator end()   { return iterator(this, numElements); }
+
+   //
+   // Access
+   //
+   T & front()             { return data[iaFront];                 }
+   T & back()              { return data[iaFromID(numElements - 1)]; }
+   const T & front() const { return data[iaFront];                 }
+   const T & back()  const { return data[iaFromID(numElements - 1)]; }
+
+   const T & operator[](size_t index) const { return data[iaFromID(index)]; }
+         T & operator[](size_t index)       { return data[iaFromID(index)]; }
+
+   //
+   // Insert
+   //
+   void push_front(const T& t) { emplace_front(t);            }
+   void push_back(const T& t)  { emplace_back(t);             }
+   void push_front(T&& t)      { emplace_front(std::move(t)); }
+   void push_back(T&& t)       { emplace_back(std::move(t));  }
+   template <class ... Args>
+   T & emplace_front(Args && ... args);
+   template <class ... Args>
+   T & emplace_back(Args && ... args);
+
+   //
+   // Remove
+   //
+   void clear()
+   {
+      if (!trivial_destroy<T, Allocator>::value)
+         for (size_t id = 0; id < numElements; id++)
+            destroy(data + iaFromID(id));
+      numElements = 0;
+      iaFront = 0;
+   }
+   void pop_front();
+   void pop_back();
+   void pop_front(T & t);   // move the front element into t, then pop it
+   void pop_back(T & t);    // move the back element into t, then pop it
+
+   //
+   // Status
+   //
+   size_t size() const { return numElements; }
+   bool empty() const  { return numElements == 0; }
+   size_t capacity() const { return numCapacity; }
+   void reserve(size_t num)
+   {
+      if (num > numCapacity)
+         resize(allocate(num), num);
+   }
+   void shrink_to_fit();
+   Allocator get_allocator() const { return alloc; }
+
+#ifdef DEBUG // make this visible to the unit tests
+public:
+#else
+private:
+#endif
+
+   size_t iaFromID(size_t id) const
+   {
+      return capacity_any::wrap(iaFront + id, numCapacity);
+   }
+
+   T * inlineData() { return reinterpret_cast<T *>(buffer); }
+   bool isInline() const { return data == reinterpret_cast<const T *>(buffer); }
+
+   void resize(T * newData, size_t newCapacity);
+   void takeElements(deque & rhs);
+   void moveOut(T * p);
+
+   // the buffer is never given to the allocator
+   T * allocate(size_t num)
+   {
+      return alloc_traits::allocate(alloc, num);
+   }
+   void deallocate(T * p, size_t num)
+   {
+      if (p != inlineData())
+         alloc_traits::deallocate(alloc, p, num);
+   }
+   void destroy(T * p)
+   {
+      if (!trivial_destroy<T, Allocator>::value)
+         alloc_traits::destroy(alloc, p);
+   }
+
+   // member variables
+   T * data;           // the buffer, or an allocated array once it overflows
+   size_t numCapacity; // the size of the data array
+   size_t numElements; // number of elements in the deque
+   size_t iaFront;     // the index of the first item in the array
+   Allocator alloc;    // where overflow arrays come from
+   alignas(T) unsigned char buffer[numInline * sizeof(T)];   // the first numInline slots
+};
+
+/******************************************************
+ * SMALL DEQUE
+ * small_deque<T, 8> is deque<T, small_buffer<8>>
+ ******************************************************/
+template <class T, size_t numInline = 8, class Allocator = std::allocator<T>>
+using small_deque = deque<T, small_buffer<numInline>, Allocator>;
+
+/**********************************************************
+ * DEQUE ITERATOR : SMALL
+ *********************************************************/
+template <class T, size_t numInline, class Allocator>
+class deque <T, small_buffer<numInline>, Allocator> ::iterator
+{
+public:
+   //
+   // Construct
+   //
+   iterator() : id(0), pDeque(nullptr) { }
+   iterator(deque *pDeque, size_t id) : id(id), pDeque(pDeque) { }
+
+   //
+   // Compare
+   //
+   bool operator == (const iterator& rhs) const { return pDeque == rhs.pDeque && id == rhs.id; }
+   bool operator != (const iterator& rhs) const { return !(*this == rhs); }
+
+   //
+   // Access
+   //
+   const T & operator * () const { return (*pDeque)[id]; }
+   T & operator * ()             { return (*pDeque)[id]; }
+
+   //
+   // Arithmetic
+   //
+   std::ptrdiff_t operator - (iterator it) const
+   {
+      return (std::ptrdiff_t)id - (std::ptrdiff_t)it.id;
+   }
+   iterator& operator += (std::ptrdiff_t offset) { id += offset; return *this; }
+   iterator& operator ++ ()                      { id++; return *this;         }
+   iterator  operator ++ (int)                   { iterator i = *this; id++; return i; }
+   iterator& operator -- ()                      { id--; return *this;         }
+   iterator  operator -- (int)                   { iterator i = *this; id--; return i; }
+
+#ifdef DEBUG // make this visible to the unit tests
+public:
+#else
+private:
+#endif
+
+   // Member variables
+   size_t id;          // deque index
+   deque *pDeque;
+};
+
+/****************************************************
+ * DEQUE : SMALL : ASSIGNMENT OPERATOR
+ ***************************************************/
+template <class T, size_t numInline, class Allocator>
+deque <T, small_buffer<numInline>, Allocator> &
+deque <T, small_buffer<numInline>, Allocator> :: operator = (const deque & rhs)
+{
+   if (this == &rhs)
+      return *this;
+
+   clear();
+   if (alloc_traits::propagate_on_container_copy_assignment::value && alloc != rhs.alloc)
+   {
+      // the array belongs to the old allocator
+      deallocate(data, numCapacity);
+      data = inlineData();
+      numCapacity = numInline;
+   }
+   propagateCopy(alloc, rhs.alloc,
+                 typename alloc_traits::propagate_on_container_copy_assignment());
+   reserve(rhs.numElements);
+   for (; numElements < rhs.numElements; ++numElements)
+      alloc_traits::construct(alloc, data + numElements, rhs[numElements]);
+   return *this;
+}
+
+/****************************************************
+ * DEQUE : SMALL : ASSIGNMENT OPERATOR - move
+ ***************************************************/
+template <class T, size_t numInline, class Allocator>
+deque <T, small_buffer<numInline>, Allocator> &
+deque <T, small_buffer<numInline>, Allocator> :: operator = (deque && rhs)
+{
+   if (this == &rhs)
+      return *this;
+
+   clear();
+   if (!rhs.isInline() &&
+       (alloc_traits::propagate_on_container_move_assignment::value || alloc == rhs.alloc))
+   {
+      deallocate(data, numCapacity);
+      data = inlineData();
+      numCapacity = numInline;
+      propagateMove(alloc, rhs.alloc,
+                    typename alloc_traits::propagate_on_container_move_assignment());
+   }
+   takeElements(rhs);
+   return *this;
+}
+
+/****************************************************
+ * DEQUE : SMALL : TAKE ELEMENTS
+ * We must be empty. Steal rhs's array if it has one we
+ * may free, otherwise move its elements across one at
+ * a time. rhs is left empty and back in its buffer.
+ ***************************************************/
+template <class T, size_t numInline, class Allocator>
+void deque <T, small_buffer<numInline>, Allocator> :: takeElements(deque & rhs)
+{
+   if (!rhs.isInline() && isInline() && alloc == rhs.alloc)
+   {
+      data        = rhs.data;
+      numCapacity = rhs.numCapacity;
+      numElements = rhs.numElements;
+      iaFront     = rhs.iaFront;
+      rhs.data = rhs.inlineData();
+      rhs.numCapacity = numInline;
+      rhs.numElements = 0;
+      rhs.iaFront = 0;
+      return;
+   }
+
+   reserve(rhs.numElements);
+   for (; numElements < rhs.numElements; ++numElements)
+      alloc_traits::construct(alloc, data + numElements, std::move(rhs[numElements]));
+   rhs.clear();
+}
+
+/****************************************************
+ * DEQUE : SMALL : SWAP
+ * Two allocated arrays trade pointers. When only one
+ * side is allocated, its array changes hands and the
+ * other side's elements wait in its unused buffer, so
+ * swap never allocates. Two buffers trade elements.
+ * The allocators follow propagate_on_container_swap.
+ ***************************************************/
+template <class T, size_t numInline, class Allocator>
+void deque <T, small_buffer<numInline>, Allocator> :: swap(deque & rhs)
+   noexcept(std::is_nothrow_move_constructible<T>::value)
+{
+   // allocators that do not propagate must be equal to swap
+   assert(alloc_traits::propagate_on_container_swap::value || alloc == rhs.alloc);
+   if (this == &rhs)
+      return;
+
+   if (!isInline() && !rhs.isInline())
+   {
+      std::swap(data,        rhs.data);
+      std::swap(numCapacity, rhs.numCapacity);
+      std::swap(numElements, rhs.numElements);
+      std::swap(iaFront,     rhs.iaFront);
+   }
+   else if (isInline() != rhs.isInline())
+   {
+      deque & dHeap   = isInline() ? rhs : *this;
+      deque & dInline = isInline() ? *this : rhs;
+
+      // dInline's elements wait in dHeap's buffer
+      T * p = dHeap.inlineData();
+      size_t num = dInline.numElements;
+      dInline.moveOut(p);
+
+      dInline.data        = dHeap.data;
+      dInline.numCapacity = dHeap.numCapacity;
+      dInline.numElements = dHeap.numElements;
+      dInline.iaFront     = dHeap.iaFront;
+      dHeap.data        = p;
+      dHeap.numCapacity = numInline;
+      dHeap.numElements = num;
+      dHeap.iaFront     = 0;
+   }
+   else
+   {
+      // both fit in a buffer, so none of these moves allocates
+      deque tmp(std::move(rhs));
+      rhs.takeElements(*this);
+      takeElements(tmp);
+   }
+   propagateSwap(alloc, rhs.alloc,
+                 typename alloc_traits::propagate_on_container_swap());
+}
+
+/****************************************************
+ * DEQUE : SMALL : MOVE OUT
+ * Move the elements, unwrapped, into the raw slots at p
+ * and leave us empty. If a move throws, nothing changes.
+ ***************************************************/
+template <class T, size_t numInline, class Allocator>
+void deque <T, small_buffer<numInline>, Allocator> :: moveOut(T * p)
+{
+   size_t i = 0;
+   try
+   {
+      for (; i < numElements; i++)
+         alloc_traits::construct(alloc, p + i, std::move(data[iaFromID(i)]));
+   }
+   catch (...)
+   {
+      while (i--)
+         destroy(p + i);
+      throw;
+   }
+   clear();
+}
+
+/****************************************************
+ * DEQUE : SMALL : RESIZE
+ * Move the elements, unwrapped, into newData, which is
+ * either a new array or the buffer. Elements are moved
+ * when T's move cannot throw and copied otherwise.
+ ***************************************************/
+template <class T, size_t numInline, class Allocator>
+void deque <T, small_buffer<numInline>, Allocator> :: resize(T * newData, size_t newCapacity)
+{
+   size_t i = 0;
+   try
+   {
+      for (; i < numElements; i++)
+         alloc_traits::construct(alloc, newData + i, std::move_if_noexcept(data[iaFromID(i)]));
+   }
+   catch (...)
+   {
+      while (i--)
+         destroy(newData + i);
+      deallocate(newData, newCapacity);
+      throw;
+   }
+
+   for (i = 0; i < numElements; i++)
+      destroy(data + iaFromID(i));
+   deallocate(data, numCapacity);
+
+   data = newData;
+   numCapacity = newCapacity;
+   iaFront = 0;
+}
+
+/****************************************************
+ * DEQUE : SMALL : SHRINK TO FIT
+ * Come back to the buffer if the elements fit in it
+ ***************************************************/
+template <class T, size_t numInline, class Allocator>
+void deque <T, small_buffer<numInline>, Allocator> :: shrink_to_fit()
+{
+   if (isInline())
+      return;
+   if (numElements <= numInline)
+      resize(inlineData(), numInline);
+   else if (numElements < numCapacity)
+      resize(allocate(numElements), numElements);
+}
+
+/******************************************************
+ * DEQUE : SMALL : EMPLACE_BACK
+ ******************************************************/
+template <class T, size_t numInline, class Allocator>
+template <class ... Args>
+T & deque <T, small_buffer<numInline>, Allocator> :: emplace_back(Args && ... args)
+{
+   if (numElements == numCapacity)
+   {
+      T t(std::forward<Args>(args)...);
+      size_t newCapacity = capacity_any::grow(numCapacity);
+      resize(allocate(newCapacity), newCapacity);
+      return emplace_back(std::move(t));
+   }
+   T * p = data + iaFromID(numElements);
+   alloc_traits::construct(alloc, p, std::forward<Args>(args)...);
+   numElements++;
+   return *p;
+}
+
+/******************************************************
+ * DEQUE : SMALL : EMPLACE_FRONT
+ ******************************************************/
+template <class T, size_t numInline, class Allocator>
+template <class ... Args>
+T & deque <T, small_buffer<numInline>, Allocator> :: emplace_front(Args && ... args)
+{
+   if (numElements == numCapacity)
+   {
+      T t(std::forward<Args>(args)...);
+      size_t newCapacity = capacity_any::grow(numCapacity);
+      resize(allocate(newCapacity), newCapacity);
+      return emplace_front(std::move(t));
+   }
+   size_t iaNew = capacity_any::wrap(iaFront + numCapacity - 1, numCapacity);
+   T * p = data + iaNew;
+   alloc_traits::construct(alloc, p, std::forward<Args>(args)...);
+   iaFront = iaNew;
+   numElements++;
+   return *p;
+}
+
+/*****************************************************
+ * DEQUE : SMALL : POP
+ *****************************************************/
+template <class T, size_t numInline, class Allocator>
+void deque <T, small_buffer<numInline>, Allocator> :: pop_back()
+{
+   numElements--;
+   destroy(data + iaFromID(numElements));
+}
+template <class T, size_t numInline, class Allocator>
+void deque <T, small_buffer<numInline>, Allocator> :: pop_front()
+{
+   numElements--;
+   destroy(data + iaFront);
+   iaFront = capacity_any::wrap(iaFront + 1, numCapacity);
+}
+template <class T, size_t numInline, class Allocator>
+void deque <T, small_buffer<numInline>, Allocator> :: pop_back(T & t)
+{
+   t = std::move(back());
+   pop_back();
+}
+template <class T, size_t numInline, class Allocator>
+void deque <T, small_buffer<numInline>, Allocator> :: pop_front(T & t)
+{
+   t = std::move(front());
+   pop_front();
+}
+
+/******************************************************
+ * SWAP : SMALL
+ ******************************************************/
+template <class T, size_t numInline, class Allocator>
+void swap(deque <T, small_buffer<numInline>, Allocator> & lhs,
+          deque <T, small_buffer<numInline>, Allocator> & rhs)
+   noexcept(std::is_nothrow_move_constructible<T>::value)
+{
+   lhs.swap(rhs);
+}
+
+} // namespace custom
@@ -0,0 +1,349 @@
+/***********************************************************************
+ * Header:
+ *    STATIC DEQUE
+ * Summary:
+ *    The fixed-capacity engine for custom::deque. All numCapacity
+ *    slots live inside the deque object; it never allocates and
+ *    never grows:
+ *
+ *        custom::static_deque<int, 64> d;   // deque<int, static_buffer<64>>
+ *        if (!d.try_push_back(99))
+ *           ...                             // full
+ *
+ *    This will contain the class definition of:
+ *        static_buffer          : tag selecting the engine and capacity
+ *        deque<T, static_buffer> : a ring of compile-time size
+ *        deque::iterator        : An iterator through the deque
+ *        static_deque           : shorthand for deque<T, static_buffer<N>>
+ * Author
+ *    Alexander Dohms, Stephen Costigan, Shaun Crook, Jonathan Colwell
+ ************************************************************************/
+
+#pragma once
+
+#include "deque.h"   // for the primary deque template, capacity_pow2
+#include <new>       // for placement new
+
+namespace custom
+{
+
+/******************************************************
+ * STATIC BUFFER
+ * Storage engine tag. The deque holds at most numCapacity
+ * elements, all of them in the object.
+ *****************************************************/
+template <size_t numCapacity>
+struct static_buffer
+{
+   static_assert(numCapacity > 0, "static_buffer needs room for at least one element");
+   static const size_t size = numCapacity;
+};
+
+/******************************************************
+ * DEQUE : STATIC
+ * The same ring as the primary deque, iaFront and
+ * numElements over an array whose size is a constant.
+ * iaFromID() folds with a mask when numCapacity is a
+ * power of two and with a compare otherwise. Either way
+ * the compiler sees the capacity.
+ *
+ * There is no growth path. push_*() on a full deque is
+ * a programming error; try_push_*() return false instead.
+ * The Allocator parameter is accepted so the engine fits
+ * the deque template, and is never used.
+ *****************************************************/
+template <class T, size_t numCapacity, class Allocator>
+class deque <T, static_buffer<numCapacity>, Allocator>
+{
+   typedef typename std::conditional<(numCapacity & (numCapacity - 1)) == 0,
+                                     capacity_pow2, capacity_any>::type Wrap;
+
+public:
+
+   //
+   // Construct
+   //
+
+   deque() : numElements(0), iaFront(0) { }
+   deque(const deque & rhs) : deque()
+   {
+      *this = rhs;
+   }
+   deque(deque && rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+      : deque()
+   {
+      takeElements(rhs);
+   }
+   ~deque()
+   {
+      clear();
+   }
+
+   //
+   // Assign
+   //
+   deque & operator = (const deque & rhs);
+   deque & operator = (deque && rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+   {
+      if (this != &rhs)
+      {
+         clear();
+         takeElements(rhs);
+      }
+      return *this;
+   }
+   void swap(deque & rhs) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+   //
+   // Iterator
+   //
+   class iterator;
+   iterator begin() { return iterator(this, 0); }
+   iterator end()   { return iterator(this, numElements); }
+
+   //
+   // Access
+   //
+   T & front()             { return *slot(iaFront);                   }
+   T & back()              { return *slot(iaFromID(numElements - 1)); }
+   const T & front() const { return *slot(iaFront);                   }
+   const T & back()  const { return *slot(iaFromID(numElements - 1)); }
+
+   const T & operator[](size_t index) const { return *slot(iaFromID(index)); }
+         T & operator[](size_t index)       { return *slot(iaFromID(index)); }
+
+   //
+   // Insert
+   //
+   void push_front(const T& t) { emplace_front(t);            }
+   void push_back(const T& t)  { emplace_back(t);             }
+   void push_front(T&& t)      { emplace_front(std::move(t)); }
+   void push_back(T&& t)       { emplace_back(std::move(t));  }
+   template <class ... Args>
+   T & emplace_front(Args && ... args);
+   template <class ... Args>
+   T & emplace_back(Args && ... args);
+
+   bool try_push_front(const T& t) { return !full() && (emplace_front(t), true);            }
+   bool try_push_back(const T& t)  { return !full() && (emplace_back(t), true);             }
+   bool try_push_front(T&& t)      { return !full() && (emplace_front(std::move(t)), true); }
+   bool try_push_back(T&& t)       { return !full() && (emplace_back(std::move(t)), true);  }
+
+   //
+   // Remove
+   //
+   void clear()
+   {
+      if (!std::is_trivially_destructible<T>::value)
+         for (size_t id = 0; id < numElements; id++)
+            slot(iaFromID(id))->~T();
+      numElements = 0;
+      iaFront = 0;
+   }
+   void pop_front();
+   void pop_back();
+   void pop_front(T & t);   // move the front element into t, then pop it
+   void pop_back(T & t);    // move the back element into t, then pop it
+
+   //
+   // Status
+   //
+   size_t size() const { return numElements; }
+   bool empty() const  { return numElements == 0; }
+   bool full() const   { return numElements == numCapacity; }
+   static constexpr size_t capacity() { return numCapacity; }
+
+#ifdef DEBUG // make this visible to the unit tests
+public:
+#else
+private:
+#endif
+
+   size_t iaFromID(size_t id) const
+   {
+      return Wrap::wrap(iaFront + id, numCapacity);
+   }
+
+         T * slot(size_t ia)       { return reinterpret_cast<T *>(buffer) + ia;       }
+   const T * slot(size_t ia) const { return reinterpret_cast<const T *>(buffer) + ia; }
+
+   void takeElements(deque & rhs);
+
+   // member variables
+   size_t numElements; // number of elements in the deque
+   size_t iaFront;     // the index of the first item in the array
+   alignas(T) unsigned char buffer[numCapacity * sizeof(T)];   // the slots
+};
+
+/******************************************************
+ * STATIC DEQUE
+ * static_deque<T, 64> is deque<T, static_buffer<64>>
+ ******************************************************/
+template <class T, size_t numCapacity>
+using static_deque = deque<T, static_buffer<numCapacity>>;
+
+/**********************************************************
+ * DEQUE ITERATOR : STATIC
+ *********************************************************/
+template <class T, size_t numCapacity, class Allocator>
+class deque <T, static_buffer<numCapacity>, Allocator> ::iterator
+{
+public:
+   //
+   // Construct
+   //
+   iterator() : id(0), pDeque(nullptr) { }
+   iterator(deque *pDeque, size_t id) : id(id), pDeque(pDeque) { }
+
+   //
+   // Compare
+   //
+   bool operator == (const iterator& rhs) const { return pDeque == rhs.pDeque && id == rhs.id; }
+   bool operator != (const iterator& rhs) const { return !(*this == rhs); }
+
+   //
+   // Access
+   //
+   const T & operator * () const { return (*pDeque)[id]; }
+   T & operator * ()             { return (*pDeque)[id]; }
+
+   //
+   // Arithmetic
+   //
+   std::ptrdiff_t operator - (iterator it) const
+   {
+      return (std::ptrdiff_t)id - (std::ptrdiff_t)it.id;
+   }
+   iterator& operator += (std::ptrdiff_t offset) { id += offset; return *this; }
+   iterator& operator ++ ()                      { id++; return *this;         }
+   iterator  operator ++ (int)                   { iterator i = *this; id++; return i; }
+   iterator& operator -- ()                      { id--; return *this;         }
+   iterator  operator -- (int)                   { iterator i = *this; id--; return i; }
+
+#ifdef DEBUG // make this visible to the unit tests
+public:
+#else
+private:
+#endif
+
+   // Member variables
+   size_t id;          // deque index
+   deque *pDeque;
+};
+
+/****************************************************
+ * DEQUE : STATIC : ASSIGNMENT OPERATOR
+ ***************************************************/
+template <class T, size_t numCapacity, class Allocator>
+deque <T, static_buffer<numCapacity>, Allocator> &
+deque <T, static_buffer<numCapacity>, Allocator> :: operator = (const deque & rhs)
+{
+   if (this == &rhs)
+      return *this;
+
+   clear();
+   for (; numElements < rhs.numElements; ++numElements)
+      new (slot(numElements)) T(rhs[numElements]);
+   return *this;
+}
+
+/****************************************************
+ * DEQUE : STATIC : TAKE ELEMENTS
+ * We must be empty. Move rhs's elements across, unwrapped,
+ * and leave rhs empty.
+ ***************************************************/
+template <class T, size_t numCapacity, class Allocator>
+void deque <T, static_buffer<numCapacity>, Allocator> :: takeElements(deque & rhs)
+{
+   for (; numElements < rhs.numElements; ++numElements)
+      new (slot(numElements)) T(std::move(rhs[numElements]));
+   rhs.clear();
+}
+
+/****************************************************
+ * DEQUE : STATIC : SWAP
+ * Nothing to trade but the elements themselves
+ ***************************************************/
+template <class T, size_t numCapacity, class Allocator>
+void deque <T, static_buffer<numCapacity>, Allocator> :: swap(deque & rhs)
+   noexcept(std::is_nothrow_move_constructible<T>::value)
+{
+   if (this == &rhs)
+      return;
+
+   deque tmp(std::move(rhs));
+   rhs.takeElements(*this);
+   takeElements(tmp);
+}
+
+/******************************************************
+ * DEQUE : STATIC : EMPLACE_BACK
+ ******************************************************/
+template <class T, size_t numCapacity, class Allocator>
+template <class ... Args>
+T & deque <T, static_buffer<numCapacity>, Allocator> :: emplace_back(Args && ... args)
+{
+   assert(!full());
+   T * p = slot(iaFromID(numElements));
+   new (p) T(std::forward<Args>(args)...);
+   numElements++;
+   return *p;
+}
+
+/******************************************************
+ * DEQUE : STATIC : EMPLACE_FRONT
+ ******************************************************/
+template <class T, size_t numCapacity, class Allocator>
+template <class ... Args>
+T & deque <T, static_buffer<numCapacity>, Allocator> :: emplace_front(Args && ... args)
+{
+   assert(!full());
+   size_t iaNew = iaFromID(numCapacity - 1);
+   T * p = slot(iaNew);
+   new (p) T(std::forward<Args>(args)...);
+   iaFront = iaNew;
+   numElements++;
+   return *p;
+}
+
+/*****************************************************
+ * DEQUE : STATIC : POP
+ *****************************************************/
+template <class T, size_t numCapacity, class Allocator>
+void deque <T, static_buffer<numCapacity>, Allocator> :: pop_back()
+{
+   numElements--;
+   slot(iaFromID(numElements))->~T();
+}
+template <class T, size_t numCapacity, class Allocator>
+void deque <T, static_buffer<numCapacity>, Allocator> :: pop_front()
+{
+   numElements--;
+   slot(iaFront)->~T();
+   iaFront = iaFromID(1);
+}
+template <class T, size_t numCapacity, class Allocator>
+void deque <T, static_buffer<numCapacity>, Allocator> :: pop_back(T & t)
+{
+   t = std::move(back());
+   pop_back();
+}
+template <class T, size_t numCapacity, class Allocator>
+void deque <T, static_buffer<numCapacity>, Allocator> :: pop_front(T & t)
+{
+   t = std::move(front());
+   pop_front();
+}
+
+/******************************************************
+ * SWAP : STATIC
+ ******************************************************/
+template <class T, size_t numCapacity, class Allocator>
+void swap(deque <T, static_buffer<numCapacity>, Allocator> & lhs,
+          deque <T, static_buffer<numCapacity>, Allocator> & rhs)
+   noexcept(std::is_nothrow_move_constructible<T>::value)
+{
+   lhs.swap(rhs);
+}
+
+} // namespace custom
@@ -0,0 +1,191 @@
+/***********************************************************************
+ * Header:
+ *    TEST BUFFER POOL
+ * Summary:
+ *    Unit tests for the buffer pool and the pool allocator
+ * Author
+ *    Alexander Dohms, Stephen Costigan, Shaun Crook, Jonathan Colwell
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "deque.h"
+#include "bufferPool.h"
+#include "unitTest.h"
+
+#include <iostream>
+
+class TestBufferPool : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Utilities
+      test_sizeClass_standard();
+
+      // Acquire and release
+      test_acquire_miss();
+      test_acquire_hit();
+      test_release_limit();
+      test_trim_standard();
+
+      // Deque
+      test_deque_recycle();
+      test_deque_local();
+      test_deque_usable();
+
+      report("BufferPool");
+   }
+
+   typedef custom::deque<int, custom::capacity_any, custom::pool_allocator<int>> Deque;
+
+   /***************************************
+    * UTILITIES
+    ***************************************/
+
+   // requests round up to a power of two, never less than 16 bytes
+   void test_sizeClass_standard()
+   {  // setup
+      // exercise
+      int c1   = custom::buffer_pool::sizeClass(1);
+      int c16  = custom::buffer_pool::sizeClass(16);
+      int c17  = custom::buffer_pool::sizeClass(17);
+      int c100 = custom::buffer_pool::sizeClass(100);
+      // verify
+      assertUnit(c1   == 4);
+      assertUnit(c16  == 4);
+      assertUnit(c17  == 5);
+      assertUnit(c100 == 7);
+      assertUnit(custom::buffer_pool::usable(100) == 128);
+   }  // teardown
+
+   /***************************************
+    * ACQUIRE and RELEASE
+    ***************************************/
+
+   // an empty pool goes to the system
+   void test_acquire_miss()
+   {  // setup
+      custom::buffer_pool pool;
+      // exercise
+      void * p = pool.acquire(40);
+      // verify
+      assertUnit(p != nullptr);
+      assertUnit(pool.hits() == 0);
+      assertUnit(pool.misses() == 1);
+      assertUnit(pool.cached() == 0);
+      pool.release(p, 40);
+   }  // teardown
+
+   // a released array comes back for any request of the same class
+   void test_acquire_hit()
+   {  // setup
+      custom::buffer_pool pool;
+      void * p1 = pool.acquire(40);
+      pool.release(p1, 40);
+      // exercise
+      void * p2 = pool.acquire(64);
+      // verify
+      assertUnit(p2 == p1);
+      assertUnit(pool.hits() == 1);
+      assertUnit(pool.misses() == 1);
+      assertUnit(pool.cached() == 0);
+      pool.release(p2, 64);
+   }  // teardown
+
+   // only numPerClass arrays are kept in a class
+   void test_release_limit()
+   {  // setup
+      custom::buffer_pool pool(/*numPerClass=*/2);
+      void * p1 = pool.acquire(32);
+      void * p2 = pool.acquire(32);
+      void * p3 = pool.acquire(32);
+      // exercise
+      pool.release(p1, 32);
+      pool.release(p2, 32);
+      pool.release(p3, 32);
+      // verify
+      assertUnit(pool.cached() == 2);
+      assertUnit(pool.numFree[5] == 2);
+   }  // teardown
+
+   // trim gives everything back
+   void test_trim_standard()
+   {  // setup
+      custom::buffer_pool pool;
+      pool.release(pool.acquire(16), 16);
+      pool.release(pool.acquire(1024), 1024);
+      // exercise
+      pool.trim();
+      // verify
+      assertUnit(pool.cached() == 0);
+      assertUnit(pool.freeList[4] == nullptr);
+      assertUnit(pool.freeList[10] == nullptr);
+   }  // teardown
+
+   /***************************************
+    * DEQUE
+    ***************************************/
+
+   // a second deque growing through the same sizes never misses
+   void test_deque_recycle()
+   {  // setup
+      custom::buffer_pool pool;
+      {
+         Deque d((custom::pool_allocator<int>(pool)));
+         for (int i = 0; i < 100; i++)
+            d.push_back(i);
+      }
+      size_t numMisses = pool.misses();
+      // exercise
+      Deque d((custom::pool_allocator<int>(pool)));
+      for (int i = 0; i < 100; i++)
+         d.push_back(i);
+      // verify
+      assertUnit(numMisses > 0);
+      assertUnit(pool.misses() == numMisses);
+      assertUnit(pool.hits() >= numMisses);
+      assertUnit(d.size() == 100);
+   }  // teardown
+
+   // by default the allocator uses the pool of the calling thread
+   void test_deque_local()
+   {  // setup
+      custom::buffer_pool & pool = custom::buffer_pool::local();
+      pool.trim();
+      pool.reset_counters();
+      // exercise
+      {
+         Deque d;
+         d.push_back(99);
+      }
+      Deque d;
+      d.push_back(99);
+      // verify
+      assertUnit(pool.misses() == 1);
+      assertUnit(pool.hits() == 1);
+   }  // teardown
+
+   // capacity_usable keeps the whole size class
+   void test_deque_usable()
+   {  // setup
+      custom::buffer_pool pool;
+      custom::deque<int, custom::capacity_usable<>, custom::pool_allocator<int>>
+         d((custom::pool_allocator<int>(pool)));
+      // exercise
+      d.push_back(99);
+      // verify
+      assertUnit(d.numCapacity == 16 / sizeof(int));
+      assertUnit(d.numElements == 1);
+      for (int i = 0; i < 4; i++)
+         d.push_back(i);
+      assertUnit(d.numCapacity == 32 / sizeof(int));
+      assertUnit(d.back() == 3);
+   }  // teardown
+};
+
+#endif // DEBUG
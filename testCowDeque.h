@@ -0,0 +1,280 @@
+/***********************************************************************
+ * Header:
+ *    TEST COW DEQUE
+ * Summary:
+ *    Unit tests for the copy-on-write deque
+ * Author
+ *    Alexander Dohms, Stephen Costigan, Shaun Crook, Jonathan Colwell
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "cowDeque.h"
+#include "unitTest.h"
+
+#include <string>
+#include <iostream>
+#include <type_traits>
+
+class TestCowDeque : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructCopy_shares();
+      test_constructMove_empties();
+
+      // Access
+      test_subscriptRead_shared();
+      test_subscriptWrite_shared();
+      test_subscriptWrite_unshareable();
+
+      // Insert
+      test_pushback_shared();
+      test_pushback_alone();
+
+      // Remove
+      test_popfront_shared();
+      test_clear_shared();
+
+      // Allocator
+#ifdef DEQUE_PMR
+      test_swap_pmr();
+      test_assign_pmr();
+#endif
+
+      report("CowDeque");
+   }
+
+   typedef custom::cow_deque<int> Deque;
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // an empty deque has nothing to share
+   void test_construct_default()
+   {  // setup
+      // exercise
+      Deque d;
+      // verify
+      assertUnit(d.pDeque == nullptr);
+      assertUnit(d.get() == nullptr);
+      assertUnit(d.size() == 0);
+      assertUnit(d.empty());
+      assertUnit(!d.shared());
+   }  // teardown
+
+   // a copy takes the same buffer
+   void test_constructCopy_shares()
+   {  // setup
+      Deque dSrc;
+      setupStandardFixture(dSrc);
+      // exercise
+      Deque dDes(dSrc);
+      // verify
+      assertUnit(dDes.pDeque == dSrc.pDeque);
+      assertUnit(dSrc.shared());
+      assertUnit(dDes.shared());
+      assertUnit(dDes.size() == 3);
+   }  // teardown
+
+   // a move hands over the buffer and the count stays at one
+   void test_constructMove_empties()
+   {  // setup
+      Deque dSrc;
+      setupStandardFixture(dSrc);
+      custom::deque<int> * p = dSrc.pDeque.get();
+      // exercise
+      Deque dDes(std::move(dSrc));
+      // verify
+      assertUnit(dSrc.pDeque == nullptr);
+      assertUnit(dSrc.empty());
+      assertUnit(dDes.pDeque.get() == p);
+      assertUnit(!dDes.shared());
+      assertUnit(std::is_nothrow_move_constructible<Deque>::value);
+      assertUnit(std::is_nothrow_move_assignable<Deque>::value);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // reading through a const deque does not copy
+   void test_subscriptRead_shared()
+   {  // setup
+      Deque dSrc;
+      setupStandardFixture(dSrc);
+      const Deque dDes(dSrc);
+      // exercise
+      int value = dDes[1];
+      // verify
+      assertUnit(value == 26);
+      assertUnit(dDes.pDeque == dSrc.pDeque);
+   }  // teardown
+
+   // writing through [] copies first
+   void test_subscriptWrite_shared()
+   {  // setup
+      Deque dSrc;
+      setupStandardFixture(dSrc);
+      Deque dDes(dSrc);
+      // exercise
+      dDes[1] = 99;
+      // verify
+      assertUnit(dDes.pDeque != dSrc.pDeque);
+      assertUnit(!dSrc.shared());
+      assertUnit(dSrc[1] == 26);
+      assertUnit(dDes[1] == 99);
+   }  // teardown
+
+   // a snapshot taken while a reference is out gets its own copy
+   void test_subscriptWrite_unshareable()
+   {  // setup
+      Deque dLive;
+      setupStandardFixture(dLive);
+      int & r = dLive[0];
+      // exercise
+      Deque dSnapshot(dLive);
+      r = 42;
+      // verify
+      assertUnit(dSnapshot.pDeque != dLive.pDeque);
+      assertUnit(!dLive.shared());
+      assertUnit(dSnapshot[0] == 11);
+      assertUnit(dLive[0] == 42);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // the snapshot does not see a later push
+   void test_pushback_shared()
+   {  // setup
+      Deque dLive;
+      setupStandardFixture(dLive);
+      Deque dSnapshot(dLive);
+      custom::deque<int> * p = dLive.pDeque.get();
+      // exercise
+      dLive.push_back(99);
+      // verify
+      assertUnit(dLive.pDeque.get() != p);
+      assertUnit(dSnapshot.pDeque.get() == p);
+      assertUnit(dLive.size() == 4);
+      assertUnit(dLive.back() == 99);
+      assertUnit(dSnapshot.size() == 3);
+      assertUnit(dSnapshot.back() == 31);
+   }  // teardown
+
+   // a deque nobody shares is changed in place
+   void test_pushback_alone()
+   {  // setup
+      Deque d;
+      setupStandardFixture(d);
+      custom::deque<int> * p = d.pDeque.get();
+      // exercise
+      d.push_back(99);
+      // verify
+      assertUnit(d.pDeque.get() == p);
+      assertUnit(d.size() == 4);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // popping a shared deque copies it first
+   void test_popfront_shared()
+   {  // setup
+      custom::cow_deque<std::string> dLive;
+      dLive.push_back("eleven");
+      dLive.push_back("twenty six");
+      custom::cow_deque<std::string> dSnapshot(dLive);
+      // exercise
+      dLive.pop_front();
+      // verify
+      assertUnit(dLive.size() == 1);
+      assertUnit(dLive.front() == "twenty six");
+      assertUnit(dSnapshot.size() == 2);
+      assertUnit(dSnapshot.front() == "eleven");
+   }  // teardown
+
+   // clear lets go of the buffer without copying it
+   void test_clear_shared()
+   {  // setup
+      Deque dLive;
+      setupStandardFixture(dLive);
+      Deque dSnapshot(dLive);
+      // exercise
+      dLive.clear();
+      // verify
+      assertUnit(dLive.pDeque == nullptr);
+      assertUnit(dLive.empty());
+      assertUnit(!dSnapshot.shared());
+      assertUnit(dSnapshot.size() == 3);
+   }  // teardown
+
+   /***************************************
+    * ALLOCATOR
+    ***************************************/
+
+#ifdef DEQUE_PMR
+   // a pmr allocator cannot be assigned, so swap leaves it alone
+   void test_swap_pmr()
+   {  // setup
+      std::pmr::monotonic_buffer_resource arena;
+      typedef custom::cow_deque<int, custom::capacity_any, std::pmr::polymorphic_allocator<int>> PmrDeque;
+      PmrDeque dLhs(&arena);
+      dLhs.push_back(11);
+      PmrDeque dRhs(&arena);
+      dRhs.push_back(26);
+      dRhs.push_back(31);
+      // exercise
+      dLhs.swap(dRhs);
+      // verify
+      assertUnit(dLhs.size() == 2);
+      assertUnit(dRhs.size() == 1);
+      assertUnit(dLhs.get_allocator().resource() == &arena);
+      if (dLhs.size() == 2 && dRhs.size() == 1)
+      {
+         assertUnit(dLhs.front() == 26);
+         assertUnit(dRhs.front() == 11);
+      }
+   }  // teardown
+
+   // assigning shares the buffer but keeps our own resource
+   void test_assign_pmr()
+   {  // setup
+      std::pmr::monotonic_buffer_resource arenaSrc;
+      std::pmr::monotonic_buffer_resource arenaDes;
+      typedef custom::cow_deque<int, custom::capacity_any, std::pmr::polymorphic_allocator<int>> PmrDeque;
+      PmrDeque dSrc(&arenaSrc);
+      dSrc.push_back(11);
+      PmrDeque dDes(&arenaDes);
+      // exercise
+      dDes = dSrc;
+      // verify
+      assertUnit(dDes.pDeque == dSrc.pDeque);
+      assertUnit(dDes.get_allocator().resource() == &arenaDes);
+   }  // teardown
+#endif // DEQUE_PMR
+
+   /****************************************************************
+    * Setup Standard Fixture
+    *    [ 11 | 26 | 31 ], owned by d alone
+    ****************************************************************/
+   void setupStandardFixture(Deque & d)
+   {
+      d.push_back(11);
+      d.push_back(26);
+      d.push_back(31);
+   }
+};
+
+#endif // DEBUG
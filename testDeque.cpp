@@ -10,6 +10,15 @@
 #define DEBUG   // Remove this to skip the unit tests
 
 #include "testDeque.h"       // for the deque unit tests
+#include "testSegmentedDeque.h" // for the segmented deque unit tests
+#include "testIncrementalDeque.h" // for the incremental deque unit tests
+#include "testSmallDeque.h"     // for the small deque unit tests
+#include "testStaticDeque.h"    // for the static deque unit tests
+#include "testCowDeque.h"       // for the copy-on-write deque unit tests
+#include "testBufferPool.h"     // for the buffer pool unit tests
+#include "testMmapAllocator.h"  // for the mmap allocator unit tests
+#include "testMirrorAllocator.h" // for the mirrored deque unit tests
+#include "testHugePageAllocator.h" // for the huge page allocator unit tests
 
 /**********************************************************************
  * MAIN
@@ -20,6 +29,21 @@ int main()
 #ifdef DEBUG
    // unit tests
    TestDeque().run();
+   TestSegmentedDeque().run();
+   TestIncrementalDeque().run();
+   TestSmallDeque().run();
+   TestStaticDeque().run();
+   TestCowDeque().run();
+   TestBufferPool().run();
+#ifdef DEQUE_MREMAP
+   TestMmapAllocator().run();
+#endif
+#ifdef DEQUE_MIRROR
+   TestMirrorAllocator().run();
+#endif
+#ifdef DEQUE_HUGEPAGE
+   TestHugePageAllocator().run();
+#endif
 #endif // DEBUG
    
    return 0;
@@ -17,8 +17,52 @@
 #include <vector>
 #include <cassert>
 #include <memory>
+#include <string>
+#include <scoped_allocator>   // for std::scoped_allocator_adaptor
+#include <stdexcept>
+#include <list>
+#include <sstream>
+#include <iterator>
+#include <cstdint>
 #include <iostream>
 
+/****************************************************************
+ * MAY THROW
+ * An element whose move is not noexcept, and throws once
+ * when movesLeft() counts down to zero. It owns memory, so
+ * the sanitizer notices one that is never destroyed.
+ ****************************************************************/
+struct MayThrow
+{
+   MayThrow(int value) : p(new int(value)) { }
+   MayThrow(MayThrow && rhs) : p(nullptr)
+   {
+      countDown();
+      p = std::move(rhs.p);
+   }
+   MayThrow & operator = (MayThrow && rhs)
+   {
+      countDown();
+      p = std::move(rhs.p);
+      return *this;
+   }
+   int value() const { return p ? *p : -1; }
+
+   static int & movesLeft() { static int num = -1; return num; }   // -1 never throws
+   static void countDown()
+   {
+      if (movesLeft() > 0)
+         movesLeft()--;
+      else if (movesLeft() == 0)
+      {
+         movesLeft() = -1;
+         throw std::runtime_error("move");
+      }
+   }
+
+   std::unique_ptr<int> p;
+};
+
 class TestDeque : public UnitTest
 {
 public:
@@ -31,11 +75,21 @@ public:
       test_iaFromID_slided();
       test_iaFromID_wrapped();
       test_iaFromID_negSlide();
+      test_iaFromID_negWrapped();
+      test_trivial_traits();
+      test_resize_trivialWrap();
+      test_grow_threeHalves();
+      test_grow_step();
 
       // Construct
       test_construct_default();
       test_constructCopy_empty();
       test_constructCopy_standard();
+      test_constructMove_standard();
+      test_constructCopy_exact();
+      test_constructCopy_wrappedString();
+      test_construct_initializerList();
+      test_construct_range();
 
       // Assign
       test_assign_emptyToEmpty();
@@ -45,6 +99,17 @@ public:
       test_assign_bigToSmall();
       test_assign_unwrap();
       test_assign_unwrapNegative();
+      test_assignMove_standardToEmpty();
+      test_swap_standardEmpty();
+      test_assign_reuse();
+      test_assign_count();
+
+      // Allocator
+#ifdef DEQUE_PMR
+      test_allocator_arena();
+      test_allocator_copySelect();
+      test_allocator_moveUnequal();
+#endif
 
       // Iterator
       test_begin_standard();
@@ -56,6 +121,7 @@ public:
       test_iterator_dereferenceWrite_standard();
       test_iterator_difference_standard();
       test_iterator_addonto_standard();
+      test_iterator_equal_standard();
 
       // Access
       test_frontRead_standard();
@@ -76,10 +142,22 @@ public:
       test_pushback_room();
       test_pushback_grow();
       test_pushback_growWrap();
+      test_pushback_growWrapNegative();
       test_pushfront_empty();
       test_pushfront_room();
       test_pushfront_grow();
       test_pushfront_growWrap();
+      test_pushfront_growWrapNegative();
+      test_push_move();
+      test_emplace_standard();
+      test_emplace_alias();
+      test_append_wrap();
+      test_append_grow();
+      test_append_input();
+      test_prepend_wrap();
+      test_insert_frontShorter();
+      test_insert_backShorter();
+      test_insert_string();
 
       // Remove
       test_clear_empty();
@@ -90,13 +168,52 @@ public:
       test_popfront_standard();
       test_popfront_wrap();
       test_popfront_wrapNegative();
+      test_pop_destroys();
+      test_clear_destroys();
+      test_pop_moveOut();
+      test_popFrontN_wrap();
+      test_popBackN_destroys();
+      test_erase_frontShorter();
+      test_erase_backShorter();
+      test_erase_destroys();
 
       // Status
       test_size_empty();
       test_size_standard();
       test_empty_empty();
       test_empty_standard();
-
+      test_reserve_wrap();
+      test_reserve_smaller();
+      test_shrinkToFit_standard();
+      test_shrinkToFit_empty();
+      test_autoShrink_hysteresis();
+#ifdef DEQUE_SPAN
+      test_asSpans_standard();
+      test_asSpans_wrap();
+      test_frontSpan_wrap();
+      test_prepare_grow();
+      test_prepareCommit_wrap();
+#endif
+      test_linearize_standard();
+      test_linearize_wrap();
+      test_linearize_gap();
+      test_linearize_string();
+      test_linearize_mayThrow();
+      test_linearize_throw();
+      test_linearize_throwOverlap();
+      test_index_compact();
+      test_index_clamp();
+      test_index_full();
+      test_index_fullPow2();
+
+      // Constant evaluation
+#ifdef DEQUE_CONSTEXPR_ALLOC
+      test_constexpr_bfs();
+      test_constexpr_copyWrapped();
+#ifdef DEQUE_SPAN
+      test_constexpr_prepareCommit();
+#endif
+#endif
 
       report("Deque");
    }
@@ -136,10 +253,10 @@ public:
       //    +----+----+----+    +    +
       // id = 1    2    0    1    2
       custom::deque<int> d;
-      d.data = new int[3];
-      d.data[2] = 11;
-      d.data[0] = 26;
-      d.data[1] = 31;
+      d.array = std::allocator<int>().allocate(3);
+      d.array[2] = 11;
+      d.array[0] = 26;
+      d.array[1] = 31;
       d.numCapacity = 3;
       d.numElements = 3;
       d.iaFront = 2;
@@ -153,50 +270,38 @@ public:
       assertUnit(ia2 == 1);
    }  // teardown
 
-   // test iaFromID where iaFront = 6
+   // test iaFromID in the power-of-two mode where iaFront = 3
    void test_iaFromID_wrapped()
    {  // setup
-      //                                 iaFront
-      // ia = 0    1    2    3    4    5    6    7    8
-      //    +----+----+----+    +    +    +    +    +    +
-      //    | 11 | 26 | 31 | 11   26   31   11   26   31
-      //    +----+----+----+    +    +    +    +    +    +
-      // id = 0    1    2    0    1    2    0    1    2
-      custom::deque<int> d;
-      d.data = new int[3];
-      d.data[0] = 11;
-      d.data[1] = 26;
-      d.data[2] = 31;
-      d.numCapacity = 3;
-      d.numElements = 3;
-      d.iaFront = 6;
+      //                  iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 |    | 11 |
+      //    +----+----+----+----+
+      // id = 1    2         0
+      custom::deque<int, custom::capacity_pow2> d;
+      setupWrappedFixture(d);
       // exercise
       int ia0 = d.iaFromID(/*id=*/0);
       int ia1 = d.iaFromID(/*id=*/1);
       int ia2 = d.iaFromID(/*id=*/2);
       // verify
-      assertUnit(ia0 == 0);
-      assertUnit(ia1 == 1);
-      assertUnit(ia2 == 2);
+      assertUnit(ia0 == 3);
+      assertUnit(ia1 == 0);
+      assertUnit(ia2 == 1);
    }  // teardown
 
-   // test iaFromID where iaFront = -1
+   // test iaFromID where iaFront is the last slot of the array
    void test_iaFromID_negSlide()
    {  // setup
-      //     iaFront
-      // ia = -1    0    1    2    
-      //     +    +----+----+----+ 
-      //       11 | 26 | 31 | 11 | 
-      //     +    +----+----+----+
-      // id =  0    1    2    0
+      //             iaFront
+      // ia = 0    1    2
+      //    +----+----+----+
+      //    | 26 | 31 | 11 |
+      //    +----+----+----+
+      // id = 1    2    0
       custom::deque<int> d;
-      d.data = new int[3];
-      d.data[0] = 26;
-      d.data[1] = 31;
-      d.data[2] = 11;
-      d.numCapacity = 3;
-      d.numElements = 3;
-      d.iaFront = -1;
+      setupWrappedFixture(d);
       // exercise
       int ia0 = d.iaFromID(/*id=*/0);
       int ia1 = d.iaFromID(/*id=*/1);
@@ -207,23 +312,23 @@ public:
       assertUnit(ia2 == 1);
    }  // teardown
 
-   // test iaFromID where iaFront = -6
+   // test iaFromID in the power-of-two mode where iaFront = 0
    void test_iaFromID_negWrapped()
    {  // setup
-      //    iaFront
-      // ia =  -6   -5   -4   -3   -2   -1   0    1    2    
-      //     +    +    +    +    +    +    +----+----+----+ 
-      //       11   26   31   11   26   31 | 11 | 26 | 31 |
-      //     +    +    +    +    +    +    +----+----+----+
-      // id =  0    1    2    0    1    2    0    1    2
-      custom::deque<int> d;
-      d.data = new int[3];
-      d.data[0] = 11;
-      d.data[1] = 26;
-      d.data[2] = 31;
-      d.numCapacity = 3;
+      //   iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 11 | 26 | 31 |    |
+      //    +----+----+----+----+
+      // id = 0    1    2
+      custom::deque<int, custom::capacity_pow2> d;
+      d.array = std::allocator<int>().allocate(4);
+      d.array[0] = 11;
+      d.array[1] = 26;
+      d.array[2] = 31;
+      d.numCapacity = 4;
       d.numElements = 3;
-      d.iaFront = -6;
+      d.iaFront = 0;
       // exercise
       int ia0 = d.iaFromID(/*id=*/0);
       int ia1 = d.iaFromID(/*id=*/1);
@@ -234,6 +339,84 @@ public:
       assertUnit(ia2 == 2);
    }  // teardown
 
+   // memcpy and no-op destruction only when the allocator adds nothing
+   void test_trivial_traits()
+   {  // setup
+      typedef std::scoped_allocator_adaptor<std::allocator<int>> Scoped;
+      // exercise
+      bool copyInt      = custom::trivial_copy<int, std::allocator<int>>::value;
+      bool copyString   = custom::trivial_copy<std::string, std::allocator<std::string>>::value;
+      bool copyScoped   = custom::trivial_copy<int, Scoped>::value;
+      bool destroyInt   = custom::trivial_destroy<int, std::allocator<int>>::value;
+      bool destroyShared = custom::trivial_destroy<std::shared_ptr<int>,
+                                                   std::allocator<std::shared_ptr<int>>>::value;
+      // verify
+      assertUnit(copyInt);
+      assertUnit(!copyString);
+      assertUnit(!copyScoped);
+      assertUnit(destroyInt);
+      assertUnit(!destroyShared);
+   }  // teardown
+
+   // growing a wrapped deque of ints unwraps it in two copies
+   void test_resize_trivialWrap()
+   {  // setup
+      //                  iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 |    | 11 |
+      //    +----+----+----+----+
+      custom::deque<int, custom::capacity_pow2> d;
+      setupWrappedFixture(d);
+      // exercise
+      d.resize(8);
+      // verify
+      //   iaFront
+      // ia = 0    1    2    3    4    5    6    7
+      //    +----+----+----+----+----+----+----+----+
+      //    | 11 | 26 | 31 |    |    |    |    |    |
+      //    +----+----+----+----+----+----+----+----+
+      assertUnit(d.numCapacity == 8);
+      assertUnit(d.numElements == 3);
+      assertUnit(d.iaFront == 0);
+      assertUnit(d.array[0] == 11);
+      assertUnit(d.array[1] == 26);
+      assertUnit(d.array[2] == 31);
+   }  // teardown
+
+   // capacity grows 1, 2, 3, 4, 6, 9, 13 ...
+   void test_grow_threeHalves()
+   {  // setup
+      custom::deque<int, custom::capacity_three_halves> d;
+      std::vector<size_t> capacities;
+      // exercise
+      for (int i = 0; i < 14; i++)
+      {
+         d.push_back(i);
+         if (capacities.empty() || capacities.back() != d.numCapacity)
+            capacities.push_back(d.numCapacity);
+      }
+      // verify
+      assertUnit(capacities == std::vector<size_t>({ 1, 2, 3, 4, 6, 9, 13, 19 }));
+      assertUnit(d.numElements == 14);
+      assertUnit(d.front() == 0);
+      assertUnit(d.back() == 13);
+   }  // teardown
+
+   // capacity grows by a fixed number of slots, wrapped or not
+   void test_grow_step()
+   {  // setup
+      custom::deque<int, custom::capacity_step<5>> d;
+      // exercise
+      for (int i = 0; i < 6; i++)
+         d.push_front(i);
+      // verify
+      assertUnit(d.numCapacity == 10);
+      assertUnit(d.numElements == 6);
+      assertUnit(d.front() == 5);
+      assertUnit(d.back() == 0);
+   }  // teardown
+
    /***************************************
     * CONSTRUCT
     ***************************************/
@@ -246,9 +429,10 @@ public:
       d.iaFront = 66;
       d.numCapacity = 77;
       d.numElements = 88;
-      d.data = (int*)0xBAADF00D;
+      d.array = (int*)0xBAADF00D;
       // exercise
-      alloc.construct(&d);  // just call the constructor by itself
+      // just call the constructor by itself
+      std::allocator_traits<std::allocator<custom::deque<int>>>::construct(alloc, &d);
       // verify
       assertEmptyFixture(d);
    }  // teardown
@@ -295,6 +479,113 @@ public:
       // teardown
    }
 
+   // a copy is only as big as the elements, and unwrapped
+   void test_constructCopy_exact()
+   {  // setup
+      //                                     iaFront
+      // ia = 0    1    2    3    4    5    6    7
+      //    +----+----+----+----+----+----+----+----+
+      //    | 26 | 31 |    |    |    |    |    | 11 |
+      //    +----+----+----+----+----+----+----+----+
+      // id = 1    2                             0
+      custom::deque<int> dSrc;
+      dSrc.array = std::allocator<int>().allocate(8);
+      dSrc.array[0] = 26;
+      dSrc.array[1] = 31;
+      dSrc.array[7] = 11;
+      dSrc.numCapacity = 8;
+      dSrc.numElements = 3;
+      dSrc.iaFront = 7;
+      // exercise
+      custom::deque<int> dDes(dSrc);
+      // verify
+      //   iaFront
+      // ia = 0    1    2
+      //    +----+----+----+
+      //    | 11 | 26 | 31 |
+      //    +----+----+----+
+      // id = 0    1    2
+      assertUnit(dSrc.numCapacity == 8);
+      assertStandardFixture(dDes);
+   }  // teardown
+
+   // both runs of a wrapped deque are copied element by element
+   void test_constructCopy_wrappedString()
+   {  // setup
+      custom::deque<std::string> dSrc;
+      dSrc.push_back("twenty six");
+      dSrc.push_back("thirty one");
+      dSrc.push_back("fifty");
+      dSrc.push_front("eleven");
+      dSrc.pop_back();
+      // exercise
+      custom::deque<std::string> dDes(dSrc);
+      // verify
+      assertUnit(dSrc.iaFront == 3);
+      assertUnit(dDes.numCapacity == 3);
+      assertUnit(dDes.numElements == 3);
+      assertUnit(dDes.iaFront == 0);
+      if (dDes.numElements == 3)
+      {
+         assertUnit(dDes.array[0] == "eleven");
+         assertUnit(dDes.array[1] == "twenty six");
+         assertUnit(dDes.array[2] == "thirty one");
+      }
+   }  // teardown
+
+   // an initializer list lands unwrapped in an exact array
+   void test_construct_initializerList()
+   {  // setup
+      // exercise
+      custom::deque<int> d{ 11, 26, 31 };
+      // verify
+      //   iaFront
+      // ia = 0    1    2
+      //    +----+----+----+
+      //    | 11 | 26 | 31 |
+      //    +----+----+----+
+      // id = 0    1    2
+      assertStandardFixture(d);
+   }  // teardown
+
+   // any forward range can build a deque
+   void test_construct_range()
+   {  // setup
+      std::list<std::string> l = { "eleven", "twenty six", "thirty one" };
+      // exercise
+      custom::deque<std::string> d(l.begin(), l.end());
+      // verify
+      assertUnit(d.numCapacity == 3);
+      assertUnit(d.numElements == 3);
+      if (d.numElements == 3)
+      {
+         assertUnit(d.array[0] == "eleven");
+         assertUnit(d.array[2] == "thirty one");
+      }
+   }  // teardown
+
+   // move constructor steals the array of a 3-element collection
+   void test_constructMove_standard()
+   {  // setup
+      //   iaFront
+      // ia = 0    1    2 
+      //    +----+----+----+
+      //    | 11 | 26 | 31 |
+      //    +----+----+----+      
+      // id = 0    1     2
+      custom::deque<int> dSrc;
+      setupStandardFixture(dSrc);
+      int * array = dSrc.array;
+      // exercise
+      custom::deque<int> dDes(std::move(dSrc));
+      // verify
+      assertEmptyFixture(dSrc);
+      assertUnit(dSrc.array == nullptr);
+      assertUnit(dSrc.numCapacity == 0);
+      assertStandardFixture(dDes);
+      assertUnit(dDes.array == array);
+   }  // teardown
+
    /***************************************
     * ASSIGN
     ***************************************/
@@ -379,9 +670,9 @@ public:
       //    +----+----+
       // id = 0    1   
       custom::deque<int> dDes;
-      dDes.data = new int[2];
-      dDes.data[0] = 85;
-      dDes.data[1] = 99;
+      dDes.array = std::allocator<int>().allocate(2);
+      dDes.array[0] = 85;
+      dDes.array[1] = 99;
       dDes.numCapacity = 2;
       dDes.numElements = 2;
       dDes.iaFront = 0;
@@ -423,11 +714,11 @@ public:
       //    +----+----+----+----+ 
       // id = 0    1    2    3
       custom::deque<int> dDes;
-      dDes.data = new int[4];
-      dDes.data[0] = 61;
-      dDes.data[1] = 73;
-      dDes.data[2] = 85;
-      dDes.data[3] = 99;
+      dDes.array = std::allocator<int>().allocate(4);
+      dDes.array[0] = 61;
+      dDes.array[1] = 73;
+      dDes.array[2] = 85;
+      dDes.array[3] = 99;
       dDes.numCapacity = 4;
       dDes.numElements = 4;
       dDes.iaFront = 0;
@@ -450,12 +741,12 @@ public:
       assertUnit(dDes.numCapacity == 4);
       assertUnit(dDes.iaFront == 0);
       assertUnit(dDes.numElements == 3);
-      assertUnit(dDes.data != nullptr);
-      if (dDes.data != nullptr && dDes.numCapacity >= 3)
+      assertUnit(dDes.array != nullptr);
+      if (dDes.array != nullptr && dDes.numCapacity >= 3)
       {
-         assertUnit(dDes.data[0] = 11);
-         assertUnit(dDes.data[1] = 26);
-         assertUnit(dDes.data[2] = 31);
+         assertUnit(dDes.array[0] = 11);
+         assertUnit(dDes.array[1] = 26);
+         assertUnit(dDes.array[2] = 31);
       }
       // teardown
    }
@@ -470,10 +761,10 @@ public:
       //    +----+----+----+    +    +
       // id = 1    2    0    1    2
       custom::deque<int> dSrc;
-      dSrc.data = new int[3];
-      dSrc.data[0] = 26;
-      dSrc.data[1] = 31;
-      dSrc.data[2] = 11;
+      dSrc.array = std::allocator<int>().allocate(3);
+      dSrc.array[0] = 26;
+      dSrc.array[1] = 31;
+      dSrc.array[2] = 11;
       dSrc.numCapacity = 3;
       dSrc.numElements = 3;
       dSrc.iaFront = 2;
@@ -490,12 +781,12 @@ public:
       assertUnit(dSrc.numCapacity == 3);
       assertUnit(dSrc.iaFront == 2);
       assertUnit(dSrc.numElements == 3);
-      assertUnit(dSrc.data != nullptr);
-      if (dSrc.data != nullptr && dSrc.numCapacity == 3)
+      assertUnit(dSrc.array != nullptr);
+      if (dSrc.array != nullptr && dSrc.numCapacity == 3)
       {
-         assertUnit(dSrc.data[0] = 26);
-         assertUnit(dSrc.data[1] = 31);
-         assertUnit(dSrc.data[2] = 11);
+         assertUnit(dSrc.array[0] = 26);
+         assertUnit(dSrc.array[1] = 31);
+         assertUnit(dSrc.array[2] = 11);
       }
       //   iaFront
       // ia = 0    1    2 
@@ -507,53 +798,183 @@ public:
       // teardown
    }
 
-   // From the standard to fixture to an empty list
+   // From the power-of-two wrapped fixture to an empty list
    void test_assign_unwrapNegative()
    {  // setup
-      //    iaFront
-      // ia = -4   -3   -2   -1   0    1    2    
-      //     +   +    +    +    +----+----+----+ 
-      //      11   26   31   11 | 26 | 31 | 11 |
-      //     +   +    +    +    +----+----+----+
-      // id = 2    0    1    2    0    1    2
-      custom::deque<int> dSrc;
-      dSrc.data = new int[3];
-      dSrc.data[0] = 26;
-      dSrc.data[1] = 31;
-      dSrc.data[2] = 11;
-      dSrc.numCapacity = 3;
-      custom::deque<int> dDes;
-      dSrc.iaFront = -4;
-      dSrc.numElements = 3;
+      //                  iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 |    | 11 |
+      //    +----+----+----+----+
+      // id = 1    2         0
+      custom::deque<int, custom::capacity_pow2> dSrc;
+      setupWrappedFixture(dSrc);
+      custom::deque<int, custom::capacity_pow2> dDes;
       // exercise
       dDes = dSrc;
       // verify
-      //    iaFront
-      // ia = -4   -3   -2   -1   0    1    2    
-      //     +   +    +    +    +----+----+----+ 
-      //      11   26   31   11 | 26 | 31 | 11 |
-      //     +   +    +    +    +----+----+----+
-      // id = 2    0    1    2    0    1    2
-      assertUnit(dSrc.numCapacity == 3);
-      assertUnit(dSrc.numElements == 3);
-      assertUnit(dSrc.iaFront == -4);
-      assertUnit(dSrc.data != nullptr);
-      if (dSrc.data != nullptr && dSrc.numCapacity == 3)
+      //                  iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 |    | 11 |
+      //    +----+----+----+----+
+      // id = 1    2         0
+      assertWrappedFixture(dSrc);
+      //   iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 11 | 26 | 31 |    |
+      //    +----+----+----+----+
+      // id = 0    1    2
+      assertUnit(dDes.iaFront == 0);
+      assertUnit(dDes.numElements == 3);
+      assertUnit(dDes.array != nullptr);
+      if (dDes.array != nullptr && dDes.numElements == 3)
       {
-         assertUnit(dSrc.data[0] = 26);
-         assertUnit(dSrc.data[1] = 31);
-         assertUnit(dSrc.data[2] = 11);
+         assertUnit(dDes.array[0] == 11);
+         assertUnit(dDes.array[1] == 26);
+         assertUnit(dDes.array[2] == 31);
       }
-      //   iaFront
-      // ia = 0    1    2 
-      //    +----+----+----+
-      //    | 11 | 26 | 31 |
-      //    +----+----+----+      
-      // id = 0    1     2
-      assertStandardFixture(dDes);
       // teardown
    }
 
+   // move the standard fixture onto an empty list
+   void test_assignMove_standardToEmpty()
+   {  // setup
+      custom::deque<int> dSrc;
+      setupStandardFixture(dSrc);
+      int * array = dSrc.array;
+      custom::deque<int> dDes;
+      // exercise
+      dDes = std::move(dSrc);
+      // verify
+      assertEmptyFixture(dSrc);
+      assertUnit(dSrc.array == nullptr);
+      assertStandardFixture(dDes);
+      assertUnit(dDes.array == array);
+   }  // teardown
+
+   // swap the standard fixture with an empty list
+   void test_swap_standardEmpty()
+   {  // setup
+      custom::deque<int> d1;
+      setupStandardFixture(d1);
+      custom::deque<int> d2;
+      // exercise
+      swap(d1, d2);
+      // verify
+      assertEmptyFixture(d1);
+      assertUnit(d1.array == nullptr);
+      assertStandardFixture(d2);
+   }  // teardown
+
+   // an array that is big enough is kept
+   void test_assign_reuse()
+   {  // setup
+      custom::deque<int> dSrc;
+      setupWrappedFixture(dSrc);
+      custom::deque<int> dDes;
+      dDes.array = std::allocator<int>().allocate(5);
+      dDes.numCapacity = 5;
+      int * array = dDes.array;
+      // exercise
+      dDes = dSrc;
+      // verify
+      assertWrappedFixture(dSrc);
+      assertUnit(dDes.array == array);
+      assertUnit(dDes.numCapacity == 5);
+      assertUnit(dDes.numElements == 3);
+      assertUnit(dDes.iaFront == 0);
+      assertUnit(dDes.array[0] == 11);
+      assertUnit(dDes.array[1] == 26);
+      assertUnit(dDes.array[2] == 31);
+   }  // teardown
+
+   // assign replaces everything with copies of one value
+   void test_assign_count()
+   {  // setup
+      custom::deque<int> d;
+      setupWrappedFixture(d);
+      // exercise
+      d.assign(4, d.front());
+      // verify
+      assertUnit(d.numElements == 4);
+      assertUnit(d.numCapacity == 6);
+      assertUnit(d.iaFront == 0);
+      if (d.numElements == 4)
+      {
+         assertUnit(d.array[0] == 11);
+         assertUnit(d.array[3] == 11);
+      }
+   }  // teardown
+
+   /***************************************
+    * ALLOCATOR
+    ***************************************/
+
+#ifdef DEQUE_PMR
+   // a pmr deque takes its arrays from the memory resource
+   void test_allocator_arena()
+   {  // setup
+      char buffer[1024];
+      std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                                std::pmr::null_memory_resource());
+      custom::pmr::deque<int> d(&arena);
+      // exercise
+      for (int i = 0; i < 10; i++)
+         d.push_back(i);
+      // verify
+      assertUnit(d.numElements == 10);
+      assertUnit((char *)d.array >= buffer);
+      assertUnit((char *)(d.array + d.numCapacity) <= buffer + sizeof(buffer));
+      assertUnit(d.get_allocator().resource() == &arena);
+   }  // teardown
+
+   // a copy asks the allocator which resource it should use
+   void test_allocator_copySelect()
+   {  // setup
+      std::pmr::monotonic_buffer_resource arena;
+      custom::pmr::deque<int> dSrc(&arena);
+      dSrc.push_back(11);
+      dSrc.push_back(26);
+      // exercise
+      custom::pmr::deque<int> dDes(dSrc);
+      // verify
+      assertUnit(dDes.get_allocator().resource() == std::pmr::get_default_resource());
+      assertUnit(dDes.numElements == 2);
+      if (dDes.numElements == 2)
+      {
+         assertUnit(dDes[0] == 11);
+         assertUnit(dDes[1] == 26);
+      }
+   }  // teardown
+
+   // moving between different resources moves the elements, not the array
+   void test_allocator_moveUnequal()
+   {  // setup
+      std::pmr::monotonic_buffer_resource arenaSrc;
+      std::pmr::monotonic_buffer_resource arenaDes;
+      custom::pmr::deque<std::pmr::string> dSrc(&arenaSrc);
+      dSrc.push_back("eleven");
+      dSrc.push_back("twenty six");
+      std::pmr::string * dataSrc = dSrc.array;
+      custom::pmr::deque<std::pmr::string> dDes(&arenaDes);
+      // exercise
+      dDes = std::move(dSrc);
+      // verify
+      assertUnit(dDes.get_allocator().resource() == &arenaDes);
+      assertUnit(dDes.array != dataSrc);
+      assertUnit(dSrc.numElements == 0);
+      assertUnit(dDes.numElements == 2);
+      if (dDes.numElements == 2)
+      {
+         assertUnit(dDes[0] == "eleven");
+         assertUnit(dDes[1] == "twenty six");
+         assertUnit(dDes[1].get_allocator().resource() == &arenaDes);
+      }
+   }  // teardown
+#endif // DEQUE_PMR
+
    /***************************************
     * ITERATOR
     ***************************************/
@@ -665,72 +1086,53 @@ public:
       // teardown
    }
 
-   // the the iterator's dereference operator to access an item from the list
+   // the the iterator's dereference operator to access an item from the wrapped list
    void test_iterator_dereferenceRead_wrap()
    {  // setup
       custom::deque<int>::iterator it;
-      //                                 iaFront
-      // ia = 0    1    2    3    4    5    6    7    8
-      //    +----+----+----+    +    +    +    +    +    +
-      //    | 11 | 26 | 31 | 11   26   31   11   26   31
-      //    +----+----+----+    +    +    +    +    +    +
-      // id = 0    1    2    0    1    2    0    1    2
-      //                                         it
+      //             iaFront
+      // ia = 0    1    2
+      //    +----+----+----+
+      //    | 26 | 31 | 11 |
+      //    +----+----+----+
+      // id = 1    2    0
       custom::deque<int> d;
-      setupStandardFixture(d);
-      d.iaFront = 6;
+      setupWrappedFixture(d);
       it.id = 1;
       it.pDeque = &d;
       int iReturn = 99;
       // exercise
       iReturn = *it;
       // verify
-      //                                 iaFront
-      // ia = 0    1    2    3    4    5    6    7    8
-      //    +----+----+----+    +    +    +    +    +    +
-      //    | 11 | 26 | 31 | 11   26   31   11   26   31
-      //    +----+----+----+    +    +    +    +    +    +
-      // id = 0    1    2    0    1    2    0    1    2
-      //                                         it
       assertUnit(iReturn == 26);
       assertUnit(it.id == 1);
       assertUnit(it.pDeque == &d);
-      d.iaFront = 0;
-      assertStandardFixture(d);
+      assertWrappedFixture(d);
       // teardown
    }
 
-   // the the iterator's dereference operator to access an item from the list
+   // the the iterator's dereference operator to access an item from the power-of-two wrapped list
    void test_iterator_dereferenceRead_wrapNegative()
    {  // setup
-      custom::deque<int>::iterator it;
-      //    iaFront
-      // ia =  -6   -5   -4   -3   -2   -1   0    1    2    
-      //     +    +    +    +    +    +    +----+----+----+ 
-      //       11   26   31   11   26   31 | 11 | 26 | 31 |
-      //     +    +    +    +    +    +    +----+----+----+
-      // id =  0    1    2    0    1    2    0    1    2
-      //            it
-      custom::deque<int> d;
-      setupStandardFixture(d);
-      d.iaFront = -6;
+      custom::deque<int, custom::capacity_pow2>::iterator it;
+      //                  iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 |    | 11 |
+      //    +----+----+----+----+
+      // id = 1    2         0
+      custom::deque<int, custom::capacity_pow2> d;
+      setupWrappedFixture(d);
       it.id = 1;
       it.pDeque = &d;
       int iReturn = 99;
       // exercise
       iReturn = *it;
       // verify
-      // ia =  -6   -5   -4   -3   -2   -1   0    1    2    
-      //     +    +    +    +    +    +    +----+----+----+ 
-      //       11   26   31   11   26   31 | 11 | 26 | 31 |
-      //     +    +    +    +    +    +    +----+----+----+
-      // id =  0    1    2    0    1    2    0    1    2
-      //            it
       assertUnit(iReturn == 26);
       assertUnit(it.id == 1);
       assertUnit(it.pDeque == &d);
-      d.iaFront = 0;
-      assertStandardFixture(d);
+      assertWrappedFixture(d);
       // teardown
    }
 
@@ -745,7 +1147,7 @@ public:
       //           it
       custom::deque<int> d;
       setupStandardFixture(d);
-      d.data[1] = 99;
+      d.array[1] = 99;
       it.id = 1;
       it.pDeque = &d;
       // exercise
@@ -822,6 +1224,23 @@ public:
       // teardown
    }
 
+   // iterators are equal only at the same position
+   void test_iterator_equal_standard()
+   {  // setup
+      custom::deque<int> d;
+      setupStandardFixture(d);
+      // exercise
+      custom::deque<int>::iterator it = d.begin();
+      ++it;
+      // verify
+      assertUnit(it != d.begin());
+      assertUnit(it != d.end());
+      ++it;
+      ++it;
+      assertUnit(it == d.end());
+      assertUnit(std::distance(d.begin(), d.end()) == 3);
+   }  // teardown
+
    /***************************************
     * FRONT and BACK
     ***************************************/
@@ -849,58 +1268,52 @@ public:
    // read front on the wrapped state
    void test_frontRead_wrap()
    {  // setup
-      //                                 iaFront
-      // ia = 0    1    2    3    4    5    6    7    8
-      //    +----+----+----+    +    +    +    +    +    +
-      //    | 11 | 26 | 31 | 11   26   31   11   26   31
-      //    +----+----+----+    +    +    +    +    +    +
-      // id = 0    1    2    0    1    2    0    1    2
+      //             iaFront
+      // ia = 0    1    2
+      //    +----+----+----+
+      //    | 26 | 31 | 11 |
+      //    +----+----+----+
+      // id = 1    2    0
       custom::deque<int> d;
-      setupStandardFixture(d);
-      d.iaFront = 6;
+      setupWrappedFixture(d);
       int s(99);
       // exercise
       s = d.front();
       // verify
       assertUnit(s == int(11));
-      // verify
-      //                                 iaFront
-      // ia = 0    1    2    3    4    5    6    7    8
-      //    +----+----+----+    +    +    +    +    +    +
-      //    | 11 | 26 | 31 | 11   26   31   11   26   31
-      //    +----+----+----+    +    +    +    +    +    +
-      // id = 0    1    2    0    1    2    0    1    2
-      d.iaFront = 0;
-      assertStandardFixture(d);
+      //             iaFront
+      // ia = 0    1    2
+      //    +----+----+----+
+      //    | 26 | 31 | 11 |
+      //    +----+----+----+
+      // id = 1    2    0
+      assertWrappedFixture(d);
       // teardown
    }
 
-   // read front in the negative wrapped state
+   // read front on the power-of-two wrapped state
    void test_frontRead_wrapNegative()
    {  // setup
-      //    iaFront
-      // ia =  -6   -5   -4   -3   -2   -1   0    1    2    
-      //     +    +    +    +    +    +    +----+----+----+ 
-      //       11   26   31   11   26   31 | 11 | 26 | 31 |
-      //     +    +    +    +    +    +    +----+----+----+
-      // id =  0    1    2    0    1    2    0    1    2
-      custom::deque<int> d;
-      setupStandardFixture(d);
-      d.iaFront = -6;
+      //                  iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 |    | 11 |
+      //    +----+----+----+----+
+      // id = 1    2         0
+      custom::deque<int, custom::capacity_pow2> d;
+      setupWrappedFixture(d);
       int s(99);
       // exercise
       s = d.front();
       // verify
       assertUnit(s == int(11));
-      // verify
-      //    iaFront
-      // ia =  -6   -5   -4   -3   -2   -1   0    1    2    
-      //     +    +    +    +    +    +    +----+----+----+ 
-      //       11   26   31   11   26   31 | 11 | 26 | 31 |
-      //     +    +    +    +    +    +    +----+----+----+
-      // id =  0    1    2    0    1    2    0    1    2
-      d.iaFront = 0;
-      assertStandardFixture(d);
+      //                  iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 |    | 11 |
+      //    +----+----+----+----+
+      // id = 1    2         0
+      assertWrappedFixture(d);
       // teardown
    }
 
@@ -919,8 +1332,8 @@ public:
       //    +----+----+----+
       //    | 99 | 26 | 31 |
       //    +----+----+----+      
-      assertUnit(d.data[0] == 99);
-      d.data[0] = 11;
+      assertUnit(d.array[0] == 99);
+      d.array[0] = 11;
       assertStandardFixture(d);
       // teardown
    }
@@ -948,58 +1361,52 @@ public:
    // read back on the wrapped state
    void test_backRead_wrap()
    {  // setup
-      //                                 iaFront
-      // ia = 0    1    2    3    4    5    6    7    8
-      //    +----+----+----+    +    +    +    +    +    +
-      //    | 11 | 26 | 31 | 11   26   31   11   26   31
-      //    +----+----+----+    +    +    +    +    +    +
-      // id = 0    1    2    0    1    2    0    1    2
+      //             iaFront
+      // ia = 0    1    2
+      //    +----+----+----+
+      //    | 26 | 31 | 11 |
+      //    +----+----+----+
+      // id = 1    2    0
       custom::deque<int> d;
-      setupStandardFixture(d);
-      d.iaFront = 6;
+      setupWrappedFixture(d);
       int s(99);
       // exercise
       s = d.back();
       // verify
       assertUnit(s == int(31));
-      // verify
-      //                                 iaFront
-      // ia = 0    1    2    3    4    5    6    7    8
-      //    +----+----+----+    +    +    +    +    +    +
-      //    | 11 | 26 | 31 | 11   26   31   11   26   31
-      //    +----+----+----+    +    +    +    +    +    +
-      // id = 0    1    2    0    1    2    0    1    2
-      d.iaFront = 0;
-      assertStandardFixture(d);
+      //             iaFront
+      // ia = 0    1    2
+      //    +----+----+----+
+      //    | 26 | 31 | 11 |
+      //    +----+----+----+
+      // id = 1    2    0
+      assertWrappedFixture(d);
       // teardown
    }
 
-   // read back in the negative wrapped state
+   // read back on the power-of-two wrapped state
    void test_backRead_wrapNegative()
    {  // setup
-      //    iaFront
-      // ia =  -6   -5   -4   -3   -2   -1   0    1    2    
-      //     +    +    +    +    +    +    +----+----+----+ 
-      //       11   26   31   11   26   31 | 11 | 26 | 31 |
-      //     +    +    +    +    +    +    +----+----+----+
-      // id =  0    1    2    0    1    2    0    1    2
-      custom::deque<int> d;
-      setupStandardFixture(d);
-      d.iaFront = -6;
+      //                  iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 |    | 11 |
+      //    +----+----+----+----+
+      // id = 1    2         0
+      custom::deque<int, custom::capacity_pow2> d;
+      setupWrappedFixture(d);
       int s(99);
       // exercise
       s = d.back();
       // verify
       assertUnit(s == int(31));
-      // verify
-      //    iaFront
-      // ia =  -6   -5   -4   -3   -2   -1   0    1    2    
-      //     +    +    +    +    +    +    +----+----+----+ 
-      //       11   26   31   11   26   31 | 11 | 26 | 31 |
-      //     +    +    +    +    +    +    +----+----+----+
-      // id =  0    1    2    0    1    2    0    1    2
-      d.iaFront = 0;
-      assertStandardFixture(d);
+      //                  iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 |    | 11 |
+      //    +----+----+----+----+
+      // id = 1    2         0
+      assertWrappedFixture(d);
       // teardown
    }
 
@@ -1018,8 +1425,8 @@ public:
       //    +----+----+----+
       //    | 11 | 26 | 99 |
       //    +----+----+----+      
-      assertUnit(d.data[2] == int(99));
-      d.data[2] = int(31);
+      assertUnit(d.array[2] == int(99));
+      d.array[2] = int(31);
       assertStandardFixture(d);
       // teardown
    }
@@ -1049,58 +1456,52 @@ public:
    // read an element from the middle of the wrapped deque
    void test_subscriptRead_wrap()
    {  // setup
-      //                                 iaFront
-      // ia = 0    1    2    3    4    5    6    7    8
-      //    +----+----+----+    +    +    +    +    +    +
-      //    | 11 | 26 | 31 | 11   26   31   11   26   31
-      //    +----+----+----+    +    +    +    +    +    +
-      // id = 0    1    2    0    1    2    0    1    2
+      //             iaFront
+      // ia = 0    1    2
+      //    +----+----+----+
+      //    | 26 | 31 | 11 |
+      //    +----+----+----+
+      // id = 1    2    0
       custom::deque<int> d;
-      setupStandardFixture(d);
-      d.iaFront = 6;
+      setupWrappedFixture(d);
       int s(99);
       // exercise
       s = d[1];
       // verify
       assertUnit(s == int(26));
-      // verify
-      //                                 iaFront
-      // ia = 0    1    2    3    4    5    6    7    8
-      //    +----+----+----+    +    +    +    +    +    +
-      //    | 11 | 26 | 31 | 11   26   31   11   26   31
-      //    +----+----+----+    +    +    +    +    +    +
-      // id = 0    1    2    0    1    2    0    1    2
-      d.iaFront = 0;
-      assertStandardFixture(d);
+      //             iaFront
+      // ia = 0    1    2
+      //    +----+----+----+
+      //    | 26 | 31 | 11 |
+      //    +----+----+----+
+      // id = 1    2    0
+      assertWrappedFixture(d);
       // teardown
    }
 
-   // read an element from the middle of the negative wrapped deque
+   // read an element from the middle of the power-of-two wrapped deque
    void test_subscriptRead_wrapNegative()
    {  // setup
-      //    iaFront
-      // ia =  -6   -5   -4   -3   -2   -1   0    1    2    
-      //     +    +    +    +    +    +    +----+----+----+ 
-      //       11   26   31   11   26   31 | 11 | 26 | 31 |
-      //     +    +    +    +    +    +    +----+----+----+
-      // id =  0    1    2    0    1    2    0    1    2
-      custom::deque<int> d;
-      setupStandardFixture(d);
-      d.iaFront = -6;
+      //                  iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 |    | 11 |
+      //    +----+----+----+----+
+      // id = 1    2         0
+      custom::deque<int, custom::capacity_pow2> d;
+      setupWrappedFixture(d);
       int s(99);
       // exercise
       s = d[1];
       // verify
       assertUnit(s == int(26));
-      // verify
-      //    iaFront
-      // ia =  -6   -5   -4   -3   -2   -1   0    1    2    
-      //     +    +    +    +    +    +    +----+----+----+ 
-      //       11   26   31   11   26   31 | 11 | 26 | 31 |
-      //     +    +    +    +    +    +    +----+----+----+
-      // id =  0    1    2    0    1    2    0    1    2
-      d.iaFront = 0;
-      assertStandardFixture(d);
+      //                  iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 |    | 11 |
+      //    +----+----+----+----+
+      // id = 1    2         0
+      assertWrappedFixture(d);
       // teardown
    }
 
@@ -1120,8 +1521,8 @@ public:
       //    | 11 | 99 | 31 |
       //    +----+----+----+      
       // id = 0    1     2
-      assertUnit(d.data[1] == 99);
-      d.data[1] = 26;
+      assertUnit(d.array[1] == 99);
+      d.array[1] = 26;
       assertStandardFixture(d);
       // teardown
    }
@@ -1144,9 +1545,9 @@ public:
       assertUnit(d.numCapacity == 1);
       assertUnit(d.numElements == 1);
       assertUnit(d.iaFront == 0);
-      assertUnit(d.data != nullptr);
+      assertUnit(d.array != nullptr);
       if (d.numElements >= 1)
-         assertUnit(d.data[0] == 99);
+         assertUnit(d.array[0] == 99);
       // teardown
    }
 
@@ -1158,7 +1559,7 @@ public:
       //    +----+----+----+      
       custom::deque<int> d;
       setupStandardFixture(d);
-      d.data[2] = 50;
+      d.array[2] = 50;
       d.numElements = 2;
       int s(31);
       // exercise
@@ -1189,85 +1590,86 @@ public:
       assertUnit(d.numCapacity == 6);
       assertUnit(d.numElements == 4);
       assertUnit(d.iaFront == 0);
-      assertUnit(d.data != nullptr);
+      assertUnit(d.array != nullptr);
       if (d.numElements >= 4)
       {
-         assertUnit(d.data[0] == 11);
-         assertUnit(d.data[1] == 26);
-         assertUnit(d.data[2] == 31);
-         assertUnit(d.data[3] == 99);
+         assertUnit(d.array[0] == 11);
+         assertUnit(d.array[1] == 26);
+         assertUnit(d.array[2] == 31);
+         assertUnit(d.array[3] == 99);
       }
       // teardown      
    }
 
-   // push back when the capacity must double
+   // push back when the capacity must double and the deque is wrapped
    void test_pushback_growWrap()
    {  // setup
-      //                                 iaFront
-      // ia = 0    1    2    3    4    5    6    7    8
-      //    +----+----+----+    +    +    +    +    +    +
-      //    | 11 | 26 | 31 | 11   26   31   11   26   31
-      //    +----+----+----+    +    +    +    +    +    +
-      // id = 0    1   2     0    1    2    0    1    2
+      //             iaFront
+      // ia = 0    1    2
+      //    +----+----+----+
+      //    | 26 | 31 | 11 |
+      //    +----+----+----+
+      // id = 1    2    0
       custom::deque<int> d;
-      setupStandardFixture(d);
-      d.iaFront = 6;
+      setupWrappedFixture(d);
       int s(99);
       // exercise
       d.push_back(s);
       // verify
       //    iaFront
-      // ia = 0    1    2    3    4    5    
+      // ia = 0    1    2    3    4    5
       //    +----+----+----+----+----+----+
       //    | 11 | 26 | 31 | 99 |    |    |
-      //    +----+----+----+----+----+----+ 
+      //    +----+----+----+----+----+----+
       // id = 0    1    2    3
       assertUnit(d.numCapacity == 6);
       assertUnit(d.numElements == 4);
       assertUnit(d.iaFront == 0);
-      assertUnit(d.data != nullptr);
+      assertUnit(d.array != nullptr);
       if (d.numElements >= 4)
       {
-         assertUnit(d.data[0] == 11);
-         assertUnit(d.data[1] == 26);
-         assertUnit(d.data[2] == 31);
-         assertUnit(d.data[3] == 99);
+         assertUnit(d.array[0] == 11);
+         assertUnit(d.array[1] == 26);
+         assertUnit(d.array[2] == 31);
+         assertUnit(d.array[3] == 99);
       }
       // teardown      
    }
 
-   // push back when the capacity must double
+   // push back when the power-of-two capacity must double
    void test_pushback_growWrapNegative()
    {  // setup
-      //    iaFront
-      // ia =  -6   -5   -4   -3   -2   -1   0    1    2    
-      //     +    +    +    +    +    +    +----+----+----+ 
-      //       11   26   31   11   26   31 | 11 | 26 | 31 |
-      //     +    +    +    +    +    +    +----+----+----+
-      // id =  0    1    2    0    1    2    0    1    2
-      custom::deque<int> d;
-      setupStandardFixture(d);
-      d.iaFront = -6;
-      int s(99);
+      //                  iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 | 99 | 11 |
+      //    +----+----+----+----+
+      // id = 1    2    3    0
+      custom::deque<int, custom::capacity_pow2> d;
+      setupWrappedFixture(d);
+      d.array[2] = 99;
+      d.numElements = 4;
+      int s(50);
       // exercise
       d.push_back(s);
       // verify
       //    iaFront
-      // ia = 0    1    2    3    4    5    
-      //    +----+----+----+----+----+----+
-      //    | 11 | 26 | 31 | 99 |    |    |
-      //    +----+----+----+----+----+----+ 
-      // id = 0    1    2    3
-      assertUnit(d.numCapacity == 6);
-      assertUnit(d.numElements == 4);
+      // ia = 0    1    2    3    4    5    6    7
+      //    +----+----+----+----+----+----+----+----+
+      //    | 11 | 26 | 31 | 99 | 50 |    |    |    |
+      //    +----+----+----+----+----+----+----+----+
+      // id = 0    1    2    3    4
+      assertUnit(d.numCapacity == 8);
+      assertUnit(d.numElements == 5);
       assertUnit(d.iaFront == 0);
-      assertUnit(d.data != nullptr);
-      if (d.numElements >= 4)
+      assertUnit(d.array != nullptr);
+      if (d.numElements >= 5)
       {
-         assertUnit(d.data[0] == 11);
-         assertUnit(d.data[1] == 26);
-         assertUnit(d.data[2] == 31);
-         assertUnit(d.data[3] == 99);
+         assertUnit(d.array[0] == 11);
+         assertUnit(d.array[1] == 26);
+         assertUnit(d.array[2] == 31);
+         assertUnit(d.array[3] == 99);
+         assertUnit(d.array[4] == 50);
       }
       // teardown      
    }
@@ -1286,18 +1688,18 @@ public:
       // exercise
       d.push_front(s);
       // verify
-      //     iaFront
-      // ia = -1    0    
-      //     +    +----+
-      //       99 | 99 |
-      //     +    +----+
-      // id =  0       
+      //   iaFront
+      // ia = 0
+      //    +----+
+      //    | 99 |
+      //    +----+
+      // id = 0
       assertUnit(d.numCapacity == 1);
       assertUnit(d.numElements == 1);
-      assertUnit(d.iaFront == -1);
-      assertUnit(d.data != nullptr);
+      assertUnit(d.iaFront == 0);
+      assertUnit(d.array != nullptr);
       if (d.numElements >= 1)
-         assertUnit(d.data[0] == 99);
+         assertUnit(d.array[0] == 99);
       // teardown
    }
 
@@ -1312,27 +1714,27 @@ public:
       // id = 0    1    
       custom::deque<int> d;
       setupStandardFixture(d);
-      d.data[2] = 50;
+      d.array[2] = 50;
       d.numElements = 2;
       int s(31);
       // exercise
       d.push_front(s);
       // verify
-      //     iaFront
-      // ia = -1    0    1    2    
-      //     +    +----+----+----+ 
-      //       31 | 11 | 26 | 31 | 
-      //     +    +----+----+----+
-      // id =  0    1    2    0
+      //             iaFront
+      // ia = 0    1    2
+      //    +----+----+----+
+      //    | 11 | 26 | 31 |
+      //    +----+----+----+
+      // id = 1    2    0
       assertUnit(d.numCapacity == 3);
       assertUnit(d.numElements == 3);
-      assertUnit(d.iaFront == -1);
-      assertUnit(d.data != nullptr);
+      assertUnit(d.iaFront == 2);
+      assertUnit(d.array != nullptr);
       if (d.numElements >= 3)
       {
-         assertUnit(d.data[0] == 11);
-         assertUnit(d.data[1] == 26);
-         assertUnit(d.data[2] == 31);
+         assertUnit(d.array[0] == 11);
+         assertUnit(d.array[1] == 26);
+         assertUnit(d.array[2] == 31);
       }
       // teardown     
    }
@@ -1352,98 +1754,254 @@ public:
       // exercise
       d.push_front(s);
       // verify
-      //     iaFront
-      // ia = -1    0    1    2    3    4    5
-      //     +    +----+----+----+----+----+----+
-      //       99 | 26 | 31 | 11 |    |    | 99 |
-      //     +    +----+----+----+----+----+----+
-      // id =  0    1    2    3              0
+      //                                 iaFront
+      // ia = 0    1    2    3    4    5
+      //    +----+----+----+----+----+----+
+      //    | 11 | 26 | 31 |    |    | 99 |
+      //    +----+----+----+----+----+----+
+      // id = 1    2    3              0
       assertUnit(d.numCapacity == 6);
       assertUnit(d.numElements == 4);
-      assertUnit(d.iaFront == -1);
-      assertUnit(d.data != nullptr);
+      assertUnit(d.iaFront == 5);
+      assertUnit(d.array != nullptr);
       if (d.numElements >= 4)
       {
-         assertUnit(d.data[0] == 11);
-         assertUnit(d.data[1] == 26);
-         assertUnit(d.data[2] == 31);
-         assertUnit(d.data[5] == 99);
+         assertUnit(d.array[0] == 11);
+         assertUnit(d.array[1] == 26);
+         assertUnit(d.array[2] == 31);
+         assertUnit(d.array[5] == 99);
       }
       // teardown      
    }
 
-   // push front when the capacity must double
+   // push front when the capacity must double and the deque is wrapped
    void test_pushfront_growWrap()
    {  // setup
-      //                                 iaFront
-      // ia = 0    1    2    3    4    5    6    7    8
-      //    +----+----+----+    +    +    +    +    +    +
-      //    | 11 | 26 | 31 | 11   26   31   11   26   31
-      //    +----+----+----+    +    +    +    +    +    +
-      // id = 0    1    2    0    1    2    0    1    2
+      //             iaFront
+      // ia = 0    1    2
+      //    +----+----+----+
+      //    | 26 | 31 | 11 |
+      //    +----+----+----+
+      // id = 1    2    0
       custom::deque<int> d;
-      setupStandardFixture(d);
-      d.iaFront = 6;
+      setupWrappedFixture(d);
       int s(99);
       // exercise
       d.push_front(s);
       // verify
-      //     iaFront
-      // ia = -1    0    1    2    3    4    5
-      //     +    +----+----+----+----+----+----+
-      //       99 | 26 | 31 | 11 |    |    | 99 |
-      //     +    +----+----+----+----+----+----+
-      // id =  0    1    2    3              0
+      //                                 iaFront
+      // ia = 0    1    2    3    4    5
+      //    +----+----+----+----+----+----+
+      //    | 11 | 26 | 31 |    |    | 99 |
+      //    +----+----+----+----+----+----+
+      // id = 1    2    3              0
       assertUnit(d.numCapacity == 6);
       assertUnit(d.numElements == 4);
-      assertUnit(d.iaFront == -1);
-      assertUnit(d.data != nullptr);
+      assertUnit(d.iaFront == 5);
+      assertUnit(d.array != nullptr);
       if (d.numElements >= 4)
       {
-         assertUnit(d.data[0] == 11);
-         assertUnit(d.data[1] == 26);
-         assertUnit(d.data[2] == 31);
-         assertUnit(d.data[5] == 99);
+         assertUnit(d.array[0] == 11);
+         assertUnit(d.array[1] == 26);
+         assertUnit(d.array[2] == 31);
+         assertUnit(d.array[5] == 99);
       }
       // teardown      
    }
 
-   // push front when the capacity must double
+   // push front onto the power-of-two wrapped state when there is room
    void test_pushfront_growWrapNegative()
    {  // setup
-      //    iaFront
-      // ia =  -6   -5   -4   -3   -2   -1   0    1    2    
-      //     +    +    +    +    +    +    +----+----+----+ 
-      //       11   26   31   11   26   31 | 11 | 26 | 31 |
-      //     +    +    +    +    +    +    +----+----+----+
-      // id =  0    1    2    0    1    2    0    1    2
-      custom::deque<int> d;
-      setupStandardFixture(d);
-      d.iaFront = -6;
+      //                  iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 |    | 11 |
+      //    +----+----+----+----+
+      // id = 1    2         0
+      custom::deque<int, custom::capacity_pow2> d;
+      setupWrappedFixture(d);
       int s(99);
       // exercise
-      d.push_back(s);
+      d.push_front(s);
       // verify
-      //     iaFront
-      // ia =  0    1    2    3    4    5
-      //     +----+----+----+----+----+----+
-      //     | 11 | 26 | 31 | 99 |    |    |
-      //     +----+----+----+----+----+----+
-      // id =  0    1    1    3         
-      assertUnit(d.numCapacity == 6);
+      //             iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 | 99 | 11 |
+      //    +----+----+----+----+
+      // id = 2    3    0    1
+      assertUnit(d.numCapacity == 4);
       assertUnit(d.numElements == 4);
-      assertUnit(d.iaFront == 0);
-      assertUnit(d.data != nullptr);
+      assertUnit(d.iaFront == 2);
+      assertUnit(d.array != nullptr);
       if (d.numElements >= 4)
       {
-         assertUnit(d.data[0] == 11);
-         assertUnit(d.data[1] == 26);
-         assertUnit(d.data[2] == 31);
-         assertUnit(d.data[3] == 99);
+         assertUnit(d.array[0] == 26);
+         assertUnit(d.array[1] == 31);
+         assertUnit(d.array[2] == 99);
+         assertUnit(d.array[3] == 11);
       }
       // teardown      
    }
 
+   // pushing an rvalue moves it into the deque instead of copying it
+   void test_push_move()
+   {  // setup
+      std::string back(100, 'b');
+      std::string front(100, 'f');
+      custom::deque<std::string> d;
+      // exercise
+      d.push_back(std::move(back));
+      d.push_front(std::move(front));
+      // verify
+      assertUnit(back.empty());
+      assertUnit(front.empty());
+      assertUnit(d.numElements == 2);
+      if (d.numElements == 2)
+      {
+         assertUnit(d[0] == std::string(100, 'f'));
+         assertUnit(d[1] == std::string(100, 'b'));
+      }
+   }  // teardown
+
+   // emplace builds the element in its slot and returns it
+   void test_emplace_standard()
+   {  // setup
+      custom::deque<std::pair<int, std::string>> d;
+      // exercise
+      std::pair<int, std::string> & back  = d.emplace_back(26, "back");
+      back.first = 31;
+      std::pair<int, std::string> & front = d.emplace_front(11, "front");
+      // verify
+      assertUnit(d.numElements == 2);
+      assertUnit(&front == &d.front());
+      assertUnit(&d.back() == &d[1]);
+      assertUnit(front.first == 11);
+      assertUnit(front.second == "front");
+      assertUnit(d.back().first == 31);
+      assertUnit(d.back().second == "back");
+   }  // teardown
+
+   // emplace an element of the deque itself while the deque must grow
+   void test_emplace_alias()
+   {  // setup
+      //    +----+----+----+
+      //    | 11 | 26 | 31 |
+      //    +----+----+----+      
+      custom::deque<int> d;
+      setupStandardFixture(d);
+      // exercise
+      d.emplace_back(d.front());
+      // verify
+      //    +----+----+----+----+----+----+
+      //    | 11 | 26 | 31 | 11 |    |    |
+      //    +----+----+----+----+----+----+   
+      assertUnit(d.numCapacity == 6);
+      assertUnit(d.numElements == 4);
+      if (d.numElements == 4)
+         assertUnit(d.array[3] == 11);
+   }  // teardown
+
+   // append fills past the end of the array, then wraps to the start
+   void test_append_wrap()
+   {  // setup
+      //                  iaFront
+      // ia = 0    1    2    3    4    5
+      //    +----+----+----+----+----+----+
+      //    |    |    |    | 11 | 26 |    |
+      //    +----+----+----+----+----+----+
+      // id =                0    1
+      custom::deque<int> d;
+      d.array = std::allocator<int>().allocate(6);
+      d.array[3] = 11;
+      d.array[4] = 26;
+      d.numCapacity = 6;
+      d.numElements = 2;
+      d.iaFront = 3;
+      int source[] = { 31, 50, 61 };
+      // exercise
+      d.append(source, source + 3);
+      // verify
+      //                  iaFront
+      // ia = 0    1    2    3    4    5
+      //    +----+----+----+----+----+----+
+      //    | 50 | 61 |    | 11 | 26 | 31 |
+      //    +----+----+----+----+----+----+
+      // id = 3    4         0    1    2
+      assertUnit(d.numCapacity == 6);
+      assertUnit(d.numElements == 5);
+      assertUnit(d.iaFront == 3);
+      assertUnit(d.array[5] == 31);
+      assertUnit(d.array[0] == 50);
+      assertUnit(d.array[1] == 61);
+   }  // teardown
+
+   // a long range grows the array once, to fit
+   void test_append_grow()
+   {  // setup
+      custom::deque<std::string> d;
+      d.push_back("zero");
+      std::vector<std::string> source(10, "ten");
+      // exercise
+      d.append(source.begin(), source.end());
+      // verify
+      assertUnit(d.numCapacity == 11);
+      assertUnit(d.numElements == 11);
+      assertUnit(d.front() == "zero");
+      assertUnit(d.back() == "ten");
+   }  // teardown
+
+   // a single-pass range is appended as it is read
+   void test_append_input()
+   {  // setup
+      std::istringstream in("11 26 31");
+      custom::deque<int> d;
+      // exercise
+      d.append(std::istream_iterator<int>(in), std::istream_iterator<int>());
+      // verify
+      assertUnit(d.numElements == 3);
+      if (d.numElements == 3)
+      {
+         assertUnit(d[0] == 11);
+         assertUnit(d[1] == 26);
+         assertUnit(d[2] == 31);
+      }
+   }  // teardown
+
+   // prepend keeps the range in order ahead of the front
+   void test_prepend_wrap()
+   {  // setup
+      //        iaFront
+      // ia = 0    1    2    3    4    5
+      //    +----+----+----+----+----+----+
+      //    |    | 26 | 31 |    |    |    |
+      //    +----+----+----+----+----+----+
+      // id =      0    1
+      custom::deque<int> d;
+      d.array = std::allocator<int>().allocate(6);
+      d.array[1] = 26;
+      d.array[2] = 31;
+      d.numCapacity = 6;
+      d.numElements = 2;
+      d.iaFront = 1;
+      int source[] = { 99, 11 };
+      // exercise
+      d.prepend(source, source + 2);
+      // verify
+      //                                 iaFront
+      // ia = 0    1    2    3    4    5
+      //    +----+----+----+----+----+----+
+      //    | 11 | 26 | 31 |    |    | 99 |
+      //    +----+----+----+----+----+----+
+      // id = 1    2    3              0
+      assertUnit(d.numElements == 4);
+      assertUnit(d.iaFront == 5);
+      assertUnit(d.array[5] == 99);
+      assertUnit(d.array[0] == 11);
+      assertUnit(d[2] == 26);
+      assertUnit(d[3] == 31);
+   }  // teardown
+
    /***************************************
     * CLEAR
     ***************************************/
@@ -1492,11 +2050,11 @@ public:
       assertUnit(d.numCapacity == 3);
       assertUnit(d.numElements == 2);
       assertUnit(d.iaFront == 0);
-      assertUnit(d.data != nullptr);
+      assertUnit(d.array != nullptr);
       if (d.numElements >= 2)
       {
-         assertUnit(d.data[0] == 11);
-         assertUnit(d.data[1] == 26);
+         assertUnit(d.array[0] == 11);
+         assertUnit(d.array[1] == 26);
       }      
       // teardown
    }
@@ -1504,65 +2062,63 @@ public:
    // remove element off the back of the wrapped state
    void test_popback_wrap()
    {  // setup
-      //                                 iaFront
-      // ia = 0    1    2    3    4    5    6    7    8
-      //    +----+----+----+    +    +    +    +    +    +
-      //    | 11 | 26 | 31 | 11   26   31   11   26   31
-      //    +----+----+----+    +    +    +    +    +    +
-      // id = 0    1    2                   0    1    2
+      //             iaFront
+      // ia = 0    1    2
+      //    +----+----+----+
+      //    | 26 | 31 | 11 |
+      //    +----+----+----+
+      // id = 1    2    0
       custom::deque<int> d;
-      setupStandardFixture(d);
-      d.iaFront = 6;
+      setupWrappedFixture(d);
       // exercise
       d.pop_back();
       // verify
-      //                                 iaFront
-      // ia = 0    1    2    3    4    5    6    7     
-      //    +----+----+----+    +    +    +    +    +   
-      //    | 11 | 26 |    | 11   26        11   26     
-      //    +----+----+----+    +    +    +    +    +   
-      // id = 0    1         0    1         0    1     
+      //             iaFront
+      // ia = 0    1    2
+      //    +----+----+----+
+      //    | 26 |    | 11 |
+      //    +----+----+----+
+      // id = 1         0
       assertUnit(d.numCapacity == 3);
       assertUnit(d.numElements == 2);
-      assertUnit(d.iaFront == 6);
-      assertUnit(d.data != nullptr);
+      assertUnit(d.iaFront == 2);
+      assertUnit(d.array != nullptr);
       if (d.numElements >= 2)
       {
-         assertUnit(d.data[0] == 11);
-         assertUnit(d.data[1] == 26);
+         assertUnit(d.array[2] == 11);
+         assertUnit(d.array[0] == 26);
       }
       // teardown
    }
 
-   //  remove element off the back of the negative wrapped state
+   //  remove element off the back of the power-of-two wrapped state
    void test_popback_wrapNegative()
    {  // setup
-      //    iaFront
-      // ia =  -6   -5   -4   -3   -2   -1   0    1    2    
-      //     +    +    +    +    +    +    +----+----+----+ 
-      //       11   26   31   11   26   31 | 11 | 26 | 31 |
-      //     +    +    +    +    +    +    +----+----+----+
-      // id =  0    1    2    0    1    2    0    1    2
-      custom::deque<int> d;
-      setupStandardFixture(d);
-      d.iaFront = -6;
+      //                  iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 |    | 11 |
+      //    +----+----+----+----+
+      // id = 1    2         0
+      custom::deque<int, custom::capacity_pow2> d;
+      setupWrappedFixture(d);
       // exercise
       d.pop_back();
       // verify
-      //    iaFront
-      // ia =  -6   -5   -4   -3   -2   -1   0    1    2    
-      //     +    +    +    +    +    +    +----+----+----+ 
-      //       11   26        11   26      | 11 | 26 |    |
-      //     +    +    +    +    +    +    +----+----+----+
-      // id =  0    1         0    1         0    1     
-      assertUnit(d.numCapacity == 3);
+      //                  iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 |    |    | 11 |
+      //    +----+----+----+----+
+      // id = 1              0
+      assertUnit(d.numCapacity == 4);
       assertUnit(d.numElements == 2);
-      assertUnit(d.iaFront == -6);
-      assertUnit(d.data != nullptr);
+      assertUnit(d.iaFront == 3);
+      assertUnit(d.array != nullptr);
       if (d.numElements >= 2)
       {
-         assertUnit(d.data[0] == 11);
-         assertUnit(d.data[1] == 26);
+         assertUnit(d.array[3] == 11);
+         assertUnit(d.array[0] == 26);
       }
       // teardown
    }
@@ -1590,11 +2146,11 @@ public:
       assertUnit(d.numCapacity == 3);
       assertUnit(d.numElements == 2);
       assertUnit(d.iaFront == 1);
-      assertUnit(d.data != nullptr);
+      assertUnit(d.array != nullptr);
       if (d.numElements >= 2)
       {
-         assertUnit(d.data[1] == 26);
-         assertUnit(d.data[2] == 31);
+         assertUnit(d.array[1] == 26);
+         assertUnit(d.array[2] == 31);
       }
       // teardown
    }
@@ -1602,104 +2158,363 @@ public:
    // remove element off the front of the wrapped state
    void test_popfront_wrap()
    {  // setup
-      //                                 iaFront
-      // ia = 0    1    2    3    4    5    6    7    8
-      //    +----+----+----+    +    +    +    +    +    +
-      //    | 11 | 26 | 31 | 11   26   31   11   26   31
-      //    +----+----+----+    +    +    +    +    +    +
-      // id = 0    1    2    0    1    2    0    1    2
+      //             iaFront
+      // ia = 0    1    2
+      //    +----+----+----+
+      //    | 26 | 31 | 11 |
+      //    +----+----+----+
+      // id = 1    2    0
       custom::deque<int> d;
-      setupStandardFixture(d);
-      d.iaFront = 6;
+      setupWrappedFixture(d);
       // exercise
       d.pop_front();
       // verify
-      //                                      iaFront
-      // ia = 0    1    2    3    4    5    6    7    8
-      //    +----+----+----+    +    +    +    +    +    +
-      //    |    | 26 | 31 |      26   31        26   31
-      //    +----+----+----+    +    +    +    +    +    +
-      // id =       0    1         0    1         0    1    
+      //   iaFront
+      // ia = 0    1    2
+      //    +----+----+----+
+      //    | 26 | 31 |    |
+      //    +----+----+----+
+      // id = 0    1
       assertUnit(d.numCapacity == 3);
       assertUnit(d.numElements == 2);
-      assertUnit(d.iaFront == 7);
-      assertUnit(d.data != nullptr);
+      assertUnit(d.iaFront == 0);
+      assertUnit(d.array != nullptr);
       if (d.numElements >= 2)
       {
-         assertUnit(d.data[1] == 26);
-         assertUnit(d.data[2] == 31);
+         assertUnit(d.array[0] == 26);
+         assertUnit(d.array[1] == 31);
       }
       // teardown
    }
 
-   //  remove element off the front of the negative wrapped state
+   //  remove element off the front of the power-of-two wrapped state
    void test_popfront_wrapNegative()
    {  // setup
-      //    iaFront
-      // ia =  -6   -5   -4   -3   -2   -1   0    1    2    
-      //     +    +    +    +    +    +    +----+----+----+ 
-      //       11   26   31   11   26   31 | 11 | 26 | 31 |
-      //     +    +    +    +    +    +    +----+----+----+
-      // id =  0    1    2    0    1    2    0    1    2
-      custom::deque<int> d;
-      setupStandardFixture(d);
-      d.iaFront = -6;
+      //                  iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 |    | 11 |
+      //    +----+----+----+----+
+      // id = 1    2         0
+      custom::deque<int, custom::capacity_pow2> d;
+      setupWrappedFixture(d);
       // exercise
       d.pop_front();
       // verify
-      //         iaFront
-      // ia =  -6   -5   -4   -3   -2   -1   0    1    2    
-      //     +    +    +    +    +    +    +----+----+----+ 
-      //            26   31        26   31 |    | 26 | 31 |
-      //     +    +    +    +    +    +    +----+----+----+
-      // id =        0    1        0    1         0    1   
-      assertUnit(d.numCapacity == 3);
+      //   iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 |    |    |
+      //    +----+----+----+----+
+      // id = 0    1
+      assertUnit(d.numCapacity == 4);
       assertUnit(d.numElements == 2);
-      assertUnit(d.iaFront == -5);
-      assertUnit(d.data != nullptr);
+      assertUnit(d.iaFront == 0);
+      assertUnit(d.array != nullptr);
       if (d.numElements >= 2)
       {
-         assertUnit(d.data[1] == 26);
-         assertUnit(d.data[2] == 31);
+         assertUnit(d.array[0] == 26);
+         assertUnit(d.array[1] == 31);
       }
       // teardown
    }
 
-   /***************************************
-    * SIZE EMPTY
-    ***************************************/
-
-    // size of graph with one node
-   void test_size_empty()
+   // popping an element runs its destructor right away
+   void test_pop_destroys()
    {  // setup
-      custom::deque<int> d;
+      std::shared_ptr<int> p = std::make_shared<int>(99);
+      custom::deque<std::shared_ptr<int>> d;
+      d.push_back(p);
+      d.push_front(p);
       // exercise
-      size_t size = d.size();
+      d.pop_back();
+      long countBack = p.use_count();
+      d.pop_front();
+      long countFront = p.use_count();
       // verify
-      assertUnit(0 == size);
-      assertEmptyFixture(d);
+      assertUnit(countBack == 2);
+      assertUnit(countFront == 1);
+      assertUnit(d.numElements == 0);
    }  // teardown
 
-   // size of graph with four nodes
-   void test_size_standard()
+   // clear destroys every element but keeps the array
+   void test_clear_destroys()
    {  // setup
-      //    +----+----+----+
-      //    | 11 | 26 | 31 |
-      //    +----+----+----+      
-      custom::deque<int> d;
-      setupStandardFixture(d);
+      std::shared_ptr<int> p = std::make_shared<int>(99);
+      custom::deque<std::shared_ptr<int>> d;
+      d.push_back(p);
+      d.push_back(p);
+      d.push_front(p);
+      size_t numCapacity = d.numCapacity;
       // exercise
-      size_t size = d.size();
+      d.clear();
       // verify
-      assertUnit(3 == size);
-      assertStandardFixture(d);
-      // teardown
-   }
+      assertUnit(p.use_count() == 1);
+      assertUnit(d.numElements == 0);
+      assertUnit(d.numCapacity == numCapacity);
+   }  // teardown
 
-   // graph with one node
-   void test_empty_empty()
+   // the pop variants hand the removed element to the caller
+   void test_pop_moveOut()
    {  // setup
-      custom::deque<int> d;
+      custom::deque<std::string> d;
+      d.push_back(std::string(100, 'a'));
+      d.push_back(std::string(100, 'b'));
+      d.push_back(std::string(100, 'c'));
+      std::string front;
+      std::string back;
+      // exercise
+      d.pop_front(front);
+      d.pop_back(back);
+      // verify
+      assertUnit(front == std::string(100, 'a'));
+      assertUnit(back == std::string(100, 'c'));
+      assertUnit(d.numElements == 1);
+      if (d.numElements == 1)
+         assertUnit(d.front() == std::string(100, 'b'));
+   }  // teardown
+
+   // near the front, only the front moves, off the start of the array
+   void test_insert_frontShorter()
+   {  // setup
+      //        iaFront
+      // ia = 0    1    2    3    4    5
+      //    +----+----+----+----+----+----+
+      //    |    | 11 | 26 | 31 | 50 |    |
+      //    +----+----+----+----+----+----+
+      custom::deque<int> d;
+      d.array = std::allocator<int>().allocate(6);
+      d.array[1] = 11;
+      d.array[2] = 26;
+      d.array[3] = 31;
+      d.array[4] = 50;
+      d.numCapacity = 6;
+      d.numElements = 4;
+      d.iaFront = 1;
+      int source[] = { 97, 98 };
+      // exercise
+      custom::deque<int>::iterator it = d.insert(d.begin() += 1, source, source + 2);
+      // verify
+      //                                 iaFront
+      // ia = 0    1    2    3    4    5
+      //    +----+----+----+----+----+----+
+      //    | 97 | 98 | 26 | 31 | 50 | 11 |
+      //    +----+----+----+----+----+----+
+      assertUnit(it.id == 1);
+      assertUnit(d.numElements == 6);
+      assertUnit(d.iaFront == 5);
+      assertUnit(d.array[5] == 11);
+      assertUnit(d.array[0] == 97);
+      assertUnit(d.array[1] == 98);
+      assertUnit(d.array[2] == 26);
+      assertUnit(d.array[4] == 50);
+   }  // teardown
+
+   // near the back, only the back moves, across the wrap point
+   void test_insert_backShorter()
+   {  // setup
+      //                            iaFront
+      // ia = 0    1    2    3    4    5
+      //    +----+----+----+----+----+----+
+      //    | 26 | 31 | 50 |    | 11 | 23 |
+      //    +----+----+----+----+----+----+
+      custom::deque<int> d;
+      d.array = std::allocator<int>().allocate(6);
+      d.array[4] = 11;
+      d.array[5] = 23;
+      d.array[0] = 26;
+      d.array[1] = 31;
+      d.array[2] = 50;
+      d.numCapacity = 6;
+      d.numElements = 5;
+      d.iaFront = 4;
+      // exercise
+      d.insert(d.begin() += 3, 99);
+      // verify
+      assertUnit(d.numElements == 6);
+      assertUnit(d.iaFront == 4);
+      assertUnit(d.array[4] == 11);
+      assertUnit(d.array[0] == 26);
+      assertUnit(d.array[1] == 99);
+      assertUnit(d.array[2] == 31);
+      assertUnit(d.array[3] == 50);
+   }  // teardown
+
+   // elements that own memory are rotated into place, and may be our own
+   void test_insert_string()
+   {  // setup
+      custom::deque<std::string> d;
+      d.push_back("twenty six");
+      d.push_back("thirty one");
+      d.push_back("fifty");
+      d.push_front("eleven");
+      // exercise
+      d.insert(d.begin() += 1, d[3]);
+      d.insert(d.end(), std::string("ninety nine"));
+      // verify
+      assertUnit(d.numElements == 6);
+      if (d.numElements == 6)
+      {
+         assertUnit(d[0] == "eleven");
+         assertUnit(d[1] == "fifty");
+         assertUnit(d[2] == "twenty six");
+         assertUnit(d[3] == "thirty one");
+         assertUnit(d[4] == "fifty");
+         assertUnit(d[5] == "ninety nine");
+      }
+   }  // teardown
+
+   // pop_front_n removes across the wrap point
+   void test_popFrontN_wrap()
+   {  // setup
+      //                       iaFront
+      // ia = 0    1    2    3    4    5
+      //    +----+----+----+----+----+----+
+      //    | 31 | 50 |    |    | 11 | 26 |
+      //    +----+----+----+----+----+----+
+      // id = 2    3              0    1
+      custom::deque<int> d;
+      d.array = std::allocator<int>().allocate(6);
+      d.array[4] = 11;
+      d.array[5] = 26;
+      d.array[0] = 31;
+      d.array[1] = 50;
+      d.numCapacity = 6;
+      d.numElements = 4;
+      d.iaFront = 4;
+      // exercise
+      d.pop_front_n(3);
+      // verify
+      assertUnit(d.numElements == 1);
+      assertUnit(d.iaFront == 1);
+      assertUnit(d.front() == 50);
+   }  // teardown
+
+   // pop_back_n runs the destructors of what it removes
+   void test_popBackN_destroys()
+   {  // setup
+      std::shared_ptr<int> p = std::make_shared<int>(99);
+      custom::deque<std::shared_ptr<int>> d;
+      d.push_back(p);
+      d.push_back(p);
+      d.push_front(p);
+      d.push_front(p);
+      // exercise
+      d.pop_back_n(3);
+      // verify
+      assertUnit(p.use_count() == 2);
+      assertUnit(d.numElements == 1);
+      assertUnit(d.front() == p);
+   }  // teardown
+
+   // erasing near the front slides the front up to close the gap
+   void test_erase_frontShorter()
+   {  // setup
+      //                       iaFront
+      // ia = 0    1    2    3    4    5
+      //    +----+----+----+----+----+----+
+      //    | 31 | 50 | 61 |    | 11 | 26 |
+      //    +----+----+----+----+----+----+
+      custom::deque<int> d;
+      d.array = std::allocator<int>().allocate(6);
+      d.array[4] = 11;
+      d.array[5] = 26;
+      d.array[0] = 31;
+      d.array[1] = 50;
+      d.array[2] = 61;
+      d.numCapacity = 6;
+      d.numElements = 5;
+      d.iaFront = 4;
+      // exercise
+      custom::deque<int>::iterator it = d.erase(d.begin() += 1, d.begin() += 2);
+      // verify
+      assertUnit(it.id == 1);
+      assertUnit(d.numElements == 4);
+      assertUnit(d.iaFront == 5);
+      assertUnit(d.array[5] == 11);
+      assertUnit(d.array[0] == 31);
+      assertUnit(d.array[2] == 61);
+   }  // teardown
+
+   // erasing near the back slides the back down across the wrap point
+   void test_erase_backShorter()
+   {  // setup
+      custom::deque<int> d;
+      d.array = std::allocator<int>().allocate(6);
+      d.array[4] = 11;
+      d.array[5] = 26;
+      d.array[0] = 31;
+      d.array[1] = 50;
+      d.array[2] = 61;
+      d.numCapacity = 6;
+      d.numElements = 5;
+      d.iaFront = 4;
+      // exercise
+      d.erase(d.begin() += 3);
+      // verify
+      assertUnit(d.numElements == 4);
+      assertUnit(d.iaFront == 4);
+      assertUnit(d.array[5] == 26);
+      assertUnit(d.array[0] == 31);
+      assertUnit(d.array[1] == 61);
+   }  // teardown
+
+   // erase runs the destructors of the elements left over at the end
+   void test_erase_destroys()
+   {  // setup
+      std::shared_ptr<int> p = std::make_shared<int>(99);
+      std::shared_ptr<int> q = std::make_shared<int>(11);
+      custom::deque<std::shared_ptr<int>> d;
+      d.push_back(q);
+      d.push_back(p);
+      d.push_back(p);
+      d.push_back(q);
+      d.push_back(q);
+      // exercise
+      d.erase(d.begin() += 1, d.begin() += 3);
+      // verify
+      assertUnit(p.use_count() == 1);
+      assertUnit(q.use_count() == 4);
+      assertUnit(d.numElements == 3);
+      assertUnit(d.front() == q);
+      assertUnit(d.back() == q);
+   }  // teardown
+
+   /***************************************
+    * SIZE EMPTY
+    ***************************************/
+
+    // size of graph with one node
+   void test_size_empty()
+   {  // setup
+      custom::deque<int> d;
+      // exercise
+      size_t size = d.size();
+      // verify
+      assertUnit(0 == size);
+      assertEmptyFixture(d);
+   }  // teardown
+
+   // size of graph with four nodes
+   void test_size_standard()
+   {  // setup
+      //    +----+----+----+
+      //    | 11 | 26 | 31 |
+      //    +----+----+----+      
+      custom::deque<int> d;
+      setupStandardFixture(d);
+      // exercise
+      size_t size = d.size();
+      // verify
+      assertUnit(3 == size);
+      assertStandardFixture(d);
+      // teardown
+   }
+
+   // graph with one node
+   void test_empty_empty()
+   {  // setup
+      custom::deque<int> d;
       // exercise
       bool empty = d.empty();
       // verify
@@ -1724,6 +2539,537 @@ public:
    }
 
 
+   /***************************************
+    * CAPACITY
+    ***************************************/
+
+   // reserve unwraps into the bigger array
+   void test_reserve_wrap()
+   {  // setup
+      custom::deque<int> d;
+      setupWrappedFixture(d);
+      // exercise
+      d.reserve(10);
+      // verify
+      assertUnit(d.capacity() == 10);
+      assertUnit(d.numElements == 3);
+      assertUnit(d.iaFront == 0);
+      assertUnit(d.array[0] == 11);
+      assertUnit(d.array[1] == 26);
+      assertUnit(d.array[2] == 31);
+   }  // teardown
+
+   // reserve never shrinks
+   void test_reserve_smaller()
+   {  // setup
+      custom::deque<int> d;
+      setupWrappedFixture(d);
+      // exercise
+      d.reserve(2);
+      // verify
+      assertWrappedFixture(d);
+   }  // teardown
+
+   // shrink_to_fit leaves no empty slots
+   void test_shrinkToFit_standard()
+   {  // setup
+      custom::deque<int, custom::capacity_pow2> d;
+      setupWrappedFixture(d);
+      d.pop_front();
+      // exercise
+      d.shrink_to_fit();
+      // verify
+      assertUnit(d.capacity() == 2);
+      assertUnit(d.numElements == 2);
+      assertUnit(d.iaFront == 0);
+      assertUnit(d.array[0] == 26);
+      assertUnit(d.array[1] == 31);
+   }  // teardown
+
+   // shrink_to_fit of an empty deque frees the array
+   void test_shrinkToFit_empty()
+   {  // setup
+      custom::deque<int> d(10);
+      // exercise
+      d.shrink_to_fit();
+      // verify
+      assertUnit(d.capacity() == 0);
+      assertUnit(d.array == nullptr);
+      d.push_back(99);
+      assertUnit(d.front() == 99);
+   }  // teardown
+
+   // halve at a quarter full, and a push right after does not grow
+   void test_autoShrink_hysteresis()
+   {  // setup
+      custom::deque<int, custom::capacity_shrink<custom::capacity_pow2>> d;
+      for (int i = 0; i < 64; i++)
+         d.push_back(i);
+      // exercise
+      while (d.size() > 17)
+         d.pop_front();
+      size_t numBefore = d.capacity();
+      d.pop_front();
+      size_t numAfter = d.capacity();
+      d.push_back(64);
+      d.pop_back();
+      // verify
+      assertUnit(numBefore == 64);
+      assertUnit(numAfter == 32);
+      assertUnit(d.capacity() == 32);
+      assertUnit(d.front() == 48);
+      assertUnit(d.back() == 63);
+      while (!d.empty())
+         d.pop_back();
+      assertUnit(d.capacity() == 16);
+   }  // teardown
+
+#ifdef DEQUE_SPAN
+   // an unwrapped deque is a single span
+   void test_asSpans_standard()
+   {  // setup
+      custom::deque<int> d;
+      setupStandardFixture(d);
+      // exercise
+      auto spans = d.as_spans();
+      // verify
+      assertUnit(spans.first.data() == d.array);
+      assertUnit(spans.first.size() == 3);
+      assertUnit(spans.second.empty());
+      assertStandardFixture(d);
+   }  // teardown
+
+   // a wrapped deque is the front run, then the start of the array
+   void test_asSpans_wrap()
+   {  // setup
+      //             iaFront
+      // ia = 0    1    2
+      //    +----+----+----+
+      //    | 26 | 31 | 11 |
+      //    +----+----+----+
+      // id = 1    2    0
+      custom::deque<int> d;
+      setupWrappedFixture(d);
+      const custom::deque<int> & dConst = d;
+      // exercise
+      auto spans = dConst.as_spans();
+      // verify
+      assertUnit(spans.first.data() == d.array + 2);
+      assertUnit(spans.first.size() == 1);
+      assertUnit(spans.second.data() == d.array);
+      assertUnit(spans.second.size() == 2);
+      assertUnit(spans.first[0] == 11);
+      assertUnit(spans.second[1] == 31);
+   }  // teardown
+
+   // the first k elements may still come in two pieces
+   void test_frontSpan_wrap()
+   {  // setup
+      custom::deque<int> d;
+      setupWrappedFixture(d);
+      // exercise
+      auto one = d.front_span(1);
+      auto two = d.front_span(2);
+      two.second[0] = 99;
+      // verify
+      assertUnit(one.first.size() == 1);
+      assertUnit(one.second.empty());
+      assertUnit(two.first.size() == 1);
+      assertUnit(two.second.size() == 1);
+      assertUnit(d[1] == 99);
+   }  // teardown
+
+   // prepare grows once when the free space is too small
+   void test_prepare_grow()
+   {  // setup
+      custom::deque<int> d;
+      setupStandardFixture(d);
+      // exercise
+      auto spans = d.prepare(2);
+      spans.first[0] = 50;
+      spans.first[1] = 99;
+      d.commit(2);
+      // verify
+      assertUnit(spans.second.empty());
+      assertUnit(d.numCapacity >= 5);
+      assertUnit(d.numElements == 5);
+      assertUnit(d[0] == 11);
+      assertUnit(d[3] == 50);
+      assertUnit(d[4] == 99);
+   }  // teardown
+
+   // free space that wraps is handed out in two runs, then consumed in order
+   void test_prepareCommit_wrap()
+   {  // setup
+      //               iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    |    |    | 11 |    |
+      //    +----+----+----+----+
+      custom::deque<int, custom::capacity_pow2> d;
+      d.array = std::allocator<int>().allocate(4);
+      d.array[2] = 11;
+      d.numCapacity = 4;
+      d.numElements = 1;
+      d.iaFront = 2;
+      // exercise
+      auto spans = d.prepare(3);
+      spans.first[0] = 26;
+      spans.second[0] = 31;
+      spans.second[1] = 50;
+      d.commit(3);
+      d.consume(2);
+      // verify
+      assertUnit(spans.first.data() == d.array + 3);
+      assertUnit(spans.first.size() == 1);
+      assertUnit(spans.second.data() == d.array);
+      assertUnit(spans.second.size() == 2);
+      assertUnit(d.numCapacity == 4);
+      assertUnit(d.numElements == 2);
+      assertUnit(d.iaFront == 0);
+      assertUnit(d.front() == 31);
+      assertUnit(d.back() == 50);
+   }  // teardown
+#endif // DEQUE_SPAN
+
+   // an unwrapped deque is already one run and does not move
+   void test_linearize_standard()
+   {  // setup
+      custom::deque<int> d;
+      setupStandardFixture(d);
+      int * p = d.array;
+      // exercise
+      int * pData = d.linearize();
+      // verify
+      assertUnit(pData == p);
+      assertUnit(d.data() == p);
+      assertStandardFixture(d);
+   }  // teardown
+
+   // a full wrapped deque rotates within its own array
+   void test_linearize_wrap()
+   {  // setup
+      //             iaFront
+      // ia = 0    1    2
+      //    +----+----+----+
+      //    | 26 | 31 | 11 |
+      //    +----+----+----+
+      custom::deque<int> d;
+      setupWrappedFixture(d);
+      int * p = d.array;
+      // exercise
+      int * pData = d.linearize();
+      // verify
+      //      iaFront
+      // ia = 0    1    2
+      //    +----+----+----+
+      //    | 11 | 26 | 31 |
+      //    +----+----+----+
+      assertUnit(pData == p);
+      assertUnit(d.array == p);
+      assertStandardFixture(d);
+   }  // teardown
+
+   // the free slot between the runs is used and ends up at the back
+   void test_linearize_gap()
+   {  // setup
+      //                  iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 |    | 11 |
+      //    +----+----+----+----+
+      custom::deque<int, custom::capacity_pow2> d;
+      setupWrappedFixture(d);
+      int * p = d.array;
+      // exercise
+      d.linearize();
+      // verify
+      assertUnit(d.array == p);
+      assertUnit(d.numCapacity == 4);
+      assertUnit(d.numElements == 3);
+      assertUnit(d.iaFront == 0);
+      assertUnit(d.data()[0] == 11);
+      assertUnit(d.data()[1] == 26);
+      assertUnit(d.data()[2] == 31);
+   }  // teardown
+
+   // elements that own memory survive, even with no free slot to slide into
+   void test_linearize_string()
+   {  // setup
+      custom::deque<std::string> d;
+      d.reserve(4);
+      d.push_back("twenty six");
+      d.push_back("thirty one");
+      d.push_front("eleven");
+      d.push_front("zero");
+      std::string * p = d.array;
+      // exercise
+      d.linearize();
+      // verify
+      assertUnit(d.array == p);
+      assertUnit(d.numCapacity == 4);
+      assertUnit(d.iaFront == 0);
+      assertUnit(d.data()[0] == "zero");
+      assertUnit(d.data()[1] == "eleven");
+      assertUnit(d.data()[2] == "twenty six");
+      assertUnit(d.data()[3] == "thirty one");
+   }  // teardown
+
+   // a move that may throw still rotates in place
+   void test_linearize_mayThrow()
+   {  // setup
+      custom::deque<MayThrow, custom::capacity_pow2> d;
+      setupMayThrowFixture(d);
+      MayThrow * p = d.array;
+      // exercise
+      d.linearize();
+      // verify
+      assertUnit(d.array == p);
+      assertUnit(d.numCapacity == 8);
+      assertUnit(d.iaFront == 0);
+      assertUnit(d.numElements == 5);
+      for (int i = 0; i < 5 && i < (int)d.numElements; i++)
+         assertUnit(d.data()[i].value() == i);
+   }  // teardown
+
+   // a move that throws while sliding puts every element back in its old slot
+   void test_linearize_throw()
+   {  // setup
+      custom::deque<MayThrow, custom::capacity_pow2> d;
+      setupMayThrowFixture(d);
+      MayThrow::movesLeft() = 1;
+      bool thrown = false;
+      // exercise
+      try
+      {
+         d.linearize();
+      }
+      catch (const std::runtime_error &)
+      {
+         thrown = true;
+      }
+      MayThrow::movesLeft() = -1;
+      // verify
+      assertUnit(thrown);
+      assertUnit(d.numElements == 5);
+      assertUnit(d.iaFront == 5);
+      assertUnit(d.size() == 5);
+      for (int i = 0; i < 5 && i < (int)d.size(); i++)
+         assertUnit(d[i].value() == i);
+   }  // teardown
+
+   // the same once the slide has run over slots the front run still holds
+   //                  iaFront
+   // ia = 0    1    2    3    4    5    6    7
+   //    +----+----+----+----+----+----+----+----+
+   //    |  6 |    |  0 |  1 |  2 |  3 |  4 |  5 |
+   //    +----+----+----+----+----+----+----+----+
+   void test_linearize_throwOverlap()
+   {  // setup
+      custom::deque<MayThrow, custom::capacity_pow2> d;
+      d.reserve(8);
+      d.push_back(MayThrow(6));
+      for (int i = 5; i >= 0; i--)
+         d.push_front(MayThrow(i));
+      MayThrow::movesLeft() = 2;
+      bool thrown = false;
+      // exercise
+      try
+      {
+         d.linearize();
+      }
+      catch (const std::runtime_error &)
+      {
+         thrown = true;
+      }
+      MayThrow::movesLeft() = -1;
+      // verify
+      assertUnit(thrown);
+      assertUnit(d.numCapacity == 8);
+      assertUnit(d.iaFront == 2);
+      assertUnit(d.size() == 7);
+      for (int i = 0; i < 7 && i < (int)d.size(); i++)
+         assertUnit(d[i].value() == i);
+   }  // teardown
+
+   // a 32-bit index makes a smaller deque that works the same
+   void test_index_compact()
+   {  // setup
+      custom::deque<int, custom::capacity_index<uint32_t>> d;
+      // exercise
+      for (int i = 0; i < 5; i++)
+         d.push_front(i);
+      d.pop_back();
+      // verify
+      assertUnit(sizeof(d) < sizeof(custom::deque<int>));
+      assertUnit(d.max_size() == 0xFFFFFFFF);
+      assertUnit(d.numElements == 4);
+      assertUnit(d.numCapacity == 8);
+      assertUnit(d.iaFront == 7);
+      assertUnit(d.front() == 4);
+      assertUnit(d.back() == 1);
+   }  // teardown
+
+   // the last doubling is held back to what the index can count
+   void test_index_clamp()
+   {  // setup
+      custom::deque<int, custom::capacity_index<unsigned char>> d;
+      for (int i = 0; i < 128; i++)
+         d.push_back(i);
+      // exercise
+      d.push_back(128);
+      // verify
+      assertUnit(d.max_size() == 255);
+      assertUnit(d.size() == 129);
+      assertUnit(d.capacity() == 255);
+      assertUnit(d.back() == 128);
+   }  // teardown
+
+   // growing past max_size() throws and changes nothing
+   void test_index_full()
+   {  // setup
+      custom::deque<int, custom::capacity_index<unsigned char>> d;
+      for (int i = 0; i < 255; i++)
+         d.push_back(i);
+      bool thrown = false;
+      // exercise
+      try
+      {
+         d.push_back(255);
+      }
+      catch (const std::length_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(d.size() == 255);
+      assertUnit(d.capacity() == 255);
+      assertUnit(d.back() == 254);
+   }  // teardown
+
+   // a power of two capacity stops at the biggest one the index can count
+   void test_index_fullPow2()
+   {  // setup
+      custom::deque<int, custom::capacity_index<unsigned char, custom::capacity_pow2>> d;
+      for (int i = 0; i < 128; i++)
+         d.push_back(i);
+      bool thrown = false;
+      // exercise
+      try
+      {
+         d.push_back(128);
+      }
+      catch (const std::length_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(d.max_size() == 128);
+      assertUnit(thrown);
+      assertUnit(d.size() == 128);
+      assertUnit(d.capacity() == 128);
+      assertUnit(d.back() == 127);
+   }  // teardown
+
+   /***************************************
+    * CONSTANT EVALUATION
+    ***************************************/
+
+#ifdef DEQUE_CONSTEXPR_ALLOC
+   // breadth-first search from node 0, done by the compiler
+   //    0 --- 1 --- 2 --- 3 --- 4
+   //     \_________________/
+   static constexpr int bfsDistance(int goal)
+   {
+      const int edges[][2] = { {0, 1}, {1, 2}, {2, 3}, {3, 4}, {0, 3} };
+      int distance[5] = { 0, -1, -1, -1, -1 };
+      custom::deque<int> d;
+      d.push_back(0);
+      while (!d.empty())
+      {
+         int node = d.front();
+         d.pop_front();
+         for (const auto & edge : edges)
+            for (int end = 0; end < 2; end++)
+               if (edge[end] == node && distance[edge[1 - end]] == -1)
+               {
+                  distance[edge[1 - end]] = distance[node] + 1;
+                  d.push_back(edge[1 - end]);
+               }
+      }
+      return distance[goal];
+   }
+
+   // wrap a deque, grow it and copy it, all at compile time
+   static constexpr int copyWrapped()
+   {
+      custom::deque<int, custom::capacity_pow2> d(4);
+      d.push_back(26);
+      d.push_back(31);
+      d.push_front(11);
+      d.push_back(50);
+      d.push_front(99);   // grows and unwraps
+      custom::deque<int, custom::capacity_pow2> dCopy(d);
+      d.clear();
+      return dCopy.size() == 5 && dCopy.capacity() == 8 && dCopy[0] == 99 &&
+             dCopy[1] == 11 && dCopy[4] == 50 ? dCopy[2] : -1;
+   }
+
+#ifdef DEQUE_SPAN
+   // fill free space that wraps, commit it and consume it at compile time
+   static constexpr int prepareCommit()
+   {
+      custom::deque<int, custom::capacity_pow2> d(4);
+      d.push_back(0);
+      d.push_back(0);
+      d.push_back(11);
+      d.consume(2);
+      auto spans = d.prepare(3);
+      int value = 26;
+      for (size_t i = 0; i < spans.first.size(); i++)
+         std::construct_at(spans.first.data() + i, value++);
+      for (size_t i = 0; i < spans.second.size(); i++)
+         std::construct_at(spans.second.data() + i, value++);
+      d.commit(3);
+      d.consume(1);
+      return spans.first.size() == 1 && d.size() == 3 && d[0] == 26 && d[2] == 28 ? d[1] : -1;
+   }
+#endif // DEQUE_SPAN
+
+   // the search is finished before the program runs
+   void test_constexpr_bfs()
+   {  // setup
+      // exercise
+      constexpr int distance = bfsDistance(4);
+      // verify
+      static_assert(distance == 2, "0 -> 3 -> 4");
+      assertUnit(distance == 2);
+   }  // teardown
+
+   // growth and the trivial copy path work without memcpy
+   void test_constexpr_copyWrapped()
+   {  // setup
+      // exercise
+      constexpr int value = copyWrapped();
+      // verify
+      static_assert(value == 26, "copy of a grown, wrapped deque");
+      assertUnit(value == 26);
+   }  // teardown
+
+#ifdef DEQUE_SPAN
+   // the buffer interface needs no memcpy either
+   void test_constexpr_prepareCommit()
+   {  // setup
+      // exercise
+      constexpr int value = prepareCommit();
+      // verify
+      static_assert(value == 27, "prepared, committed and consumed");
+      assertUnit(value == 27);
+   }  // teardown
+#endif // DEQUE_SPAN
+#endif // DEQUE_CONSTEXPR_ALLOC
+
    /****************************************************************
     * Setup Standard Fixture
     *      iaFront
@@ -1735,16 +3081,79 @@ public:
     ****************************************************************/
    void setupStandardFixture(custom::deque<int>& d)
    {
-      d.data = new int[3];
-      d.data[0] = 11;
-      d.data[1] = 26;
-      d.data[2] = 31;
+      d.array = std::allocator<int>().allocate(3);
+      d.array[0] = 11;
+      d.array[1] = 26;
+      d.array[2] = 31;
 
       d.numCapacity = 3;
       d.numElements = 3;
       d.iaFront = 0;
    }
 
+   /****************************************************************
+    * Setup Wrapped Fixture
+    *                iaFront
+    *    ia = 0    1    2
+    *       +----+----+----+
+    *       | 26 | 31 | 11 |
+    *       +----+----+----+
+    *    id = 1    2    0
+    ****************************************************************/
+   void setupWrappedFixture(custom::deque<int>& d)
+   {
+      d.array = std::allocator<int>().allocate(3);
+      d.array[0] = 26;
+      d.array[1] = 31;
+      d.array[2] = 11;
+
+      d.numCapacity = 3;
+      d.numElements = 3;
+      d.iaFront = 2;
+   }
+
+   /****************************************************************
+    * Setup Wrapped Fixture : power-of-two capacity
+    *                     iaFront
+    *    ia = 0    1    2    3
+    *       +----+----+----+----+
+    *       | 26 | 31 |    | 11 |
+    *       +----+----+----+----+
+    *    id = 1    2         0
+    ****************************************************************/
+   void setupWrappedFixture(custom::deque<int, custom::capacity_pow2>& d)
+   {
+      d.array = std::allocator<int>().allocate(4);
+      d.array[0] = 26;
+      d.array[1] = 31;
+      d.array[2] = 50;
+      d.array[3] = 11;
+
+      d.numCapacity = 4;
+      d.numElements = 3;
+      d.iaFront = 3;
+   }
+
+   /****************************************************************
+    * Setup May Throw Fixture
+    *                                       iaFront
+    *    ia = 0    1    2    3    4    5    6    7
+    *       +----+----+----+----+----+----+----+----+
+    *       |  3 |  4 |    |    |    |  0 |  1 |  2 |
+    *       +----+----+----+----+----+----+----+----+
+    *    id = 3    4                   0    1    2
+    ****************************************************************/
+   void setupMayThrowFixture(custom::deque<MayThrow, custom::capacity_pow2>& d)
+   {
+      d.reserve(8);
+      d.push_back(MayThrow(3));
+      d.push_back(MayThrow(4));
+      d.push_front(MayThrow(2));
+      d.push_front(MayThrow(1));
+      d.push_front(MayThrow(0));
+      assert(d.numCapacity == 8 && d.iaFront == 5);
+   }
+
    /****************************************************************
     * Verify Empty Fixture
     ****************************************************************/
@@ -1770,13 +3179,47 @@ public:
       assertIndirect(d.numCapacity == 3);
       assertIndirect(d.iaFront == 0);
       assertIndirect(d.numElements == 3);
-      assertIndirect(d.data != nullptr);
+      assertIndirect(d.array != nullptr);
+
+      if (d.numCapacity == 3 && d.array != nullptr)
+      {
+         assertIndirect(d.array[0] == 11);
+         assertIndirect(d.array[1] == 26);
+         assertIndirect(d.array[2] == 31);
+      }
+   }
+
+   /****************************************************************
+    * Verify Wrapped Fixture
+    ****************************************************************/
+   void assertWrappedFixtureParameters(const custom::deque<int>& d, int line, const char* function)
+   {
+      // verify the member variables
+      assertIndirect(d.numCapacity == 3);
+      assertIndirect(d.iaFront == 2);
+      assertIndirect(d.numElements == 3);
+      assertIndirect(d.array != nullptr);
+
+      if (d.numCapacity == 3 && d.array != nullptr)
+      {
+         assertIndirect(d.array[0] == 26);
+         assertIndirect(d.array[1] == 31);
+         assertIndirect(d.array[2] == 11);
+      }
+   }
+   void assertWrappedFixtureParameters(const custom::deque<int, custom::capacity_pow2>& d, int line, const char* function)
+   {
+      // verify the member variables
+      assertIndirect(d.numCapacity == 4);
+      assertIndirect(d.iaFront == 3);
+      assertIndirect(d.numElements == 3);
+      assertIndirect(d.array != nullptr);
 
-      if (d.numCapacity == 3 && d.data != nullptr)
+      if (d.numCapacity == 4 && d.array != nullptr)
       {
-         assertIndirect(d.data[0] == 11);
-         assertIndirect(d.data[1] == 26);
-         assertIndirect(d.data[2] == 31);
+         assertIndirect(d.array[0] == 26);
+         assertIndirect(d.array[1] == 31);
+         assertIndirect(d.array[3] == 11);
       }
    }
 };
@@ -0,0 +1,148 @@
+/***********************************************************************
+ * Header:
+ *    TEST HUGE PAGE ALLOCATOR
+ * Summary:
+ *    Unit tests for the huge page allocator
+ * Author
+ *    Alexander Dohms, Stephen Costigan, Shaun Crook, Jonathan Colwell
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "deque.h"
+#include "hugePageAllocator.h"
+#include "unitTest.h"
+
+#include <iostream>
+
+#ifdef DEQUE_HUGEPAGE
+
+class TestHugePageAllocator : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Allocator
+      test_allocate_small();
+      test_allocate_aligned();
+      test_allocate_hugeTLB();
+
+      // Deque
+      test_deque_usable();
+      test_deque_usableShrink();
+      test_deque_usableShrinkPop();
+
+      report("HugePageAllocator");
+   }
+
+   static const size_t numHuge = (size_t)2 << 20;
+
+   /***************************************
+    * ALLOCATOR
+    ***************************************/
+
+   // under the threshold nothing is rounded
+   void test_allocate_small()
+   {  // setup
+      custom::huge_page_allocator<int> alloc;
+      // exercise
+      auto result = alloc.allocate_at_least(100);
+      // verify
+      assertUnit(result.ptr != nullptr);
+      assertUnit(result.count == 100);
+      alloc.deallocate(result.ptr, result.count);
+   }  // teardown
+
+   // over the threshold the array is whole 2MB pages on a 2MB boundary
+   void test_allocate_aligned()
+   {  // setup
+      custom::huge_page_allocator<int, 4096> alloc;
+      // exercise
+      auto result = alloc.allocate_at_least(5000);
+      // verify
+      assertUnit(result.ptr != nullptr);
+      assertUnit((uintptr_t)result.ptr % numHuge == 0);
+      assertUnit(result.count == numHuge / sizeof(int));
+      result.ptr[result.count - 1] = 99;
+      assertUnit(result.ptr[result.count - 1] == 99);
+      alloc.deallocate(result.ptr, result.count);
+   }  // teardown
+
+   // with no huge pages reserved, MAP_HUGETLB quietly falls back
+   void test_allocate_hugeTLB()
+   {  // setup
+      custom::huge_page_allocator<int, 4096, /*useHugeTLB=*/true> alloc;
+      // exercise
+      int * p = alloc.allocate(5000);
+      // verify
+      assertUnit(p != nullptr);
+      assertUnit((uintptr_t)p % numHuge == 0);
+      p[4999] = 99;
+      assertUnit(p[4999] == 99);
+      alloc.deallocate(p, 5000);
+   }  // teardown
+
+   /***************************************
+    * DEQUE
+    ***************************************/
+
+   // capacity_usable grows straight to a whole huge page
+   void test_deque_usable()
+   {  // setup
+      custom::deque<int, custom::capacity_usable<>,
+                    custom::huge_page_allocator<int, 4096>> d;
+      // exercise
+      for (int i = 0; i < 2000; i++)
+         d.push_back(i);
+      // verify
+      assertUnit(d.capacity() == numHuge / sizeof(int));
+      assertUnit((uintptr_t)d.array % numHuge == 0);
+      assertUnit(d.front() == 0);
+      assertUnit(d.back() == 1999);
+   }  // teardown
+
+   // shrinking on top of capacity_usable still keeps the whole page
+   void test_deque_usableShrink()
+   {  // setup
+      custom::deque<int, custom::capacity_shrink<custom::capacity_usable<>>,
+                    custom::huge_page_allocator<int, 4096>> d;
+      // exercise
+      for (int i = 0; i < 2000; i++)
+         d.push_back(i);
+      // verify
+      assertUnit(d.capacity() == numHuge / sizeof(int));
+      assertUnit(d.back() == 1999);
+   }  // teardown
+
+   // halving a whole page comes back as the same page, so popping does
+   // not copy the array until it fits under the threshold
+   void test_deque_usableShrinkPop()
+   {  // setup
+      custom::deque<int, custom::capacity_shrink<custom::capacity_usable<>>,
+                    custom::huge_page_allocator<int, 4096>> d;
+      for (int i = 0; i < 2000; i++)
+         d.push_back(i);
+      int * p = d.array;
+      size_t numMoves = 0;
+      // exercise
+      while (d.size() > 10)
+      {
+         d.pop_front();
+         if (d.array != p)
+            numMoves++;
+         p = d.array;
+      }
+      // verify
+      assertUnit(numMoves == 5);
+      assertUnit(d.capacity() == 32);
+      assertUnit(d.front() == 1990);
+      assertUnit(d.back() == 1999);
+   }  // teardown
+};
+
+#endif // DEQUE_HUGEPAGE
+#endif // DEBUG
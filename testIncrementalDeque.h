@@ -0,0 +1,343 @@
+/***********************************************************************
+ * Header:
+ *    TEST INCREMENTAL DEQUE
+ * Summary:
+ *    Unit tests for the incremental-growth storage engine of deque
+ * Author
+ *    Alexander Dohms, Stephen Costigan, Shaun Crook, Jonathan Colwell
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "deque.h"
+#include "unitTest.h"
+
+#include <string>
+#include <memory>
+#include <iostream>
+
+class TestIncrementalDeque : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Utilities
+      test_address_migrating();
+
+      // Construct
+      test_constructCopy_migrating();
+      test_constructMove_migrating();
+
+      // Insert
+      test_pushback_grow();
+      test_pushback_finish();
+      test_pushfront_migrating();
+      test_push_many();
+
+      // Remove
+      test_popfront_waiting();
+      test_popback_waiting();
+      test_clear_migrating();
+
+      // Status
+      test_reserve_migrating();
+
+      // Iterator
+      test_iterator_wide();
+
+      report("IncrementalDeque");
+   }
+
+   typedef custom::deque<int, custom::incremental<1>> Deque;
+
+   /***************************************
+    * UTILITIES
+    ***************************************/
+
+   // slots still waiting are read from the old array
+   void test_address_migrating()
+   {  // setup
+      Deque d;
+      setupMigratingFixture(d);
+      // exercise
+      int * p0 = d.address(0);
+      int * p1 = d.address(1);
+      int * p3 = d.address(3);
+      // verify
+      assertUnit(p0 == d.data + 0);
+      assertUnit(p1 == d.dataOld + 0);
+      assertUnit(p3 == d.dataOld + 2);
+      assertUnit(d[0] == 11);
+      assertUnit(d[1] == 26);
+      assertUnit(d[2] == 31);
+      assertUnit(d[3] == 50);
+   }  // teardown
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // a copy of a migrating deque is not migrating
+   void test_constructCopy_migrating()
+   {  // setup
+      Deque dSrc;
+      setupMigratingFixture(dSrc);
+      // exercise
+      Deque dDes(dSrc);
+      // verify
+      assertMigratingFixture(dSrc);
+      assertUnit(dDes.dataOld == nullptr);
+      assertUnit(dDes.numElements == 4);
+      if (dDes.numElements == 4)
+      {
+         assertUnit(dDes[0] == 11);
+         assertUnit(dDes[1] == 26);
+         assertUnit(dDes[2] == 31);
+         assertUnit(dDes[3] == 50);
+      }
+   }  // teardown
+
+   // the move constructor takes both arrays
+   void test_constructMove_migrating()
+   {  // setup
+      Deque dSrc;
+      setupMigratingFixture(dSrc);
+      // exercise
+      Deque dDes(std::move(dSrc));
+      // verify
+      assertUnit(dSrc.data == nullptr);
+      assertUnit(dSrc.dataOld == nullptr);
+      assertUnit(dSrc.numElements == 0);
+      assertMigratingFixture(dDes);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // a push into a full deque starts a migration and moves one element
+   void test_pushback_grow()
+   {  // setup
+      //   iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 11 | 26 | 31 | 50 |
+      //    +----+----+----+----+
+      Deque d;
+      d.data = std::allocator<int>().allocate(4);
+      d.data[0] = 11;
+      d.data[1] = 26;
+      d.data[2] = 31;
+      d.data[3] = 50;
+      d.numCapacity = 4;
+      d.numElements = 4;
+      int * dataOld = d.data;
+      // exercise
+      d.push_back(99);
+      // verify
+      assertUnit(d.numCapacity == 8);
+      assertUnit(d.numElements == 5);
+      assertUnit(d.dataOld == dataOld);
+      assertUnit(d.iaLow == 1);
+      assertUnit(d.iaHigh == 4);
+      assertUnit(d.data[0] == 11);
+      assertUnit(d.data[4] == 99);
+      assertUnit(d[3] == 50);
+   }  // teardown
+
+   // the last waiting element frees the old array
+   void test_pushback_finish()
+   {  // setup
+      Deque d;
+      setupMigratingFixture(d);
+      // exercise
+      d.push_back(77);
+      d.push_back(88);
+      d.push_back(99);
+      // verify
+      assertUnit(d.dataOld == nullptr);
+      assertUnit(d.iaLow == d.iaHigh);
+      assertUnit(d.numElements == 7);
+      assertUnit(d.data[1] == 26);
+      assertUnit(d.data[3] == 50);
+      assertUnit(d.back() == 99);
+   }  // teardown
+
+   // push front wraps to the end of the new array
+   void test_pushfront_migrating()
+   {  // setup
+      Deque d;
+      setupMigratingFixture(d);
+      // exercise
+      d.push_front(99);
+      // verify
+      assertUnit(d.iaFront == 7);
+      assertUnit(d.data[7] == 99);
+      assertUnit(d.iaLow == 2);
+      assertUnit(d.front() == 99);
+      assertUnit(d[1] == 11);
+      assertUnit(d[2] == 26);
+      assertUnit(d[4] == 50);
+   }  // teardown
+
+   // many pushes at both ends, each one O(1)
+   void test_push_many()
+   {  // setup
+      custom::deque<std::string, custom::incremental<2>> d;
+      // exercise
+      for (int i = 0; i < 100; i++)
+      {
+         d.push_back(std::to_string(i));
+         d.push_front(std::to_string(-i));
+      }
+      // verify
+      assertUnit(d.size() == 200);
+      bool inOrder = true;
+      for (int i = 0; i < 100; i++)
+         inOrder = inOrder && d[99 - i] == std::to_string(-i) && d[100 + i] == std::to_string(i);
+      assertUnit(inOrder);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // popping a waiting front element takes it out of the old array
+   void test_popfront_waiting()
+   {  // setup
+      Deque d;
+      setupMigratingFixture(d);
+      d.iaFront = 1;                // drop the 11, so 26 is first
+      d.numElements = 3;
+      // exercise
+      d.pop_front();
+      // verify
+      assertUnit(d.numElements == 2);
+      assertUnit(d.iaFront == 2);
+      assertUnit(d.iaLow == 3);
+      assertUnit(d.iaHigh == 4);
+      assertUnit(d.front() == 31);
+      assertUnit(d.back() == 50);
+   }  // teardown
+
+   // popping a waiting back element shortens what is left to migrate
+   void test_popback_waiting()
+   {  // setup
+      Deque d;
+      setupMigratingFixture(d);
+      // exercise
+      d.pop_back();
+      // verify
+      assertUnit(d.numElements == 3);
+      assertUnit(d.iaLow == 2);
+      assertUnit(d.iaHigh == 3);
+      assertUnit(d[0] == 11);
+      assertUnit(d[1] == 26);
+      assertUnit(d[2] == 31);
+   }  // teardown
+
+   // clear destroys the elements in both arrays
+   void test_clear_migrating()
+   {  // setup
+      std::shared_ptr<int> p = std::make_shared<int>(99);
+      custom::deque<std::shared_ptr<int>, custom::incremental<1>> d;
+      for (int i = 0; i < 5; i++)
+         d.push_back(p);
+      // exercise
+      d.clear();
+      // verify
+      assertUnit(p.use_count() == 1);
+      assertUnit(d.numElements == 0);
+      assertUnit(d.dataOld == nullptr);
+   }  // teardown
+
+   /***************************************
+    * STATUS
+    ***************************************/
+
+   // reserve ends the migration at once
+   void test_reserve_migrating()
+   {  // setup
+      Deque d;
+      setupMigratingFixture(d);
+      // exercise
+      d.reserve(20);
+      // verify
+      assertUnit(d.capacity() == 20);
+      assertUnit(d.dataOld == nullptr);
+      assertUnit(d.iaFront == 0);
+      assertUnit(d.data[0] == 11);
+      assertUnit(d.data[3] == 50);
+   }  // teardown
+
+   // ids and distances are as wide as size_t, past what an int holds
+   void test_iterator_wide()
+   {  // setup
+      Deque d;
+      size_t idFar = (size_t)std::numeric_limits<std::ptrdiff_t>::max() / 2 + 1;
+      Deque::iterator itFar(&d, idFar);
+      // exercise
+      std::ptrdiff_t distance = itFar - d.begin();
+      itFar += -(std::ptrdiff_t)idFar;
+      // verify
+      assertUnit(distance == (std::ptrdiff_t)idFar);
+      assertUnit(itFar == d.begin());
+   }  // teardown
+
+   /****************************************************************
+    * Setup Migrating Fixture
+    *   iaFront   iaLow        iaHigh
+    * ia = 0    1    2    3    4    5    6    7
+    *    +----+----+----+----+----+----+----+----+
+    *    | 11 |    |    |    |    |    |    |    |   data
+    *    +----+----+----+----+----+----+----+----+
+    *           |         |
+    *         +----+----+----+
+    *         | 26 | 31 | 50 |                       dataOld
+    *         +----+----+----+
+    *   iaFrontOld = 2, numCapacityOld = 3
+    ****************************************************************/
+   void setupMigratingFixture(Deque & d)
+   {
+      d.data = std::allocator<int>().allocate(8);
+      d.numCapacity = 8;
+      d.data[0] = 11;
+      d.dataOld = std::allocator<int>().allocate(3);
+      d.numCapacityOld = 3;
+      d.iaFrontOld = 2;
+      d.dataOld[0] = 26;
+      d.dataOld[1] = 31;
+      d.dataOld[2] = 50;
+      d.iaLow = 1;
+      d.iaHigh = 4;
+      d.iaFront = 0;
+      d.numElements = 4;
+   }
+
+   /****************************************************************
+    * Verify Migrating Fixture
+    ****************************************************************/
+   void assertMigratingFixtureParameters(const Deque & d, int line, const char* function)
+   {
+      assertIndirect(d.numCapacity == 8);
+      assertIndirect(d.numElements == 4);
+      assertIndirect(d.iaFront == 0);
+      assertIndirect(d.iaLow == 1);
+      assertIndirect(d.iaHigh == 4);
+      assertIndirect(d.dataOld != nullptr);
+
+      if (d.data && d.dataOld)
+      {
+         assertIndirect(d.data[0] == 11);
+         assertIndirect(d.dataOld[0] == 26);
+         assertIndirect(d.dataOld[1] == 31);
+         assertIndirect(d.dataOld[2] == 50);
+      }
+   }
+};
+
+#endif // DEBUG
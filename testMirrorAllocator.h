@@ -0,0 +1,143 @@
+/***********************************************************************
+ * Header:
+ *    TEST MIRROR ALLOCATOR
+ * Summary:
+ *    Unit tests for the mirror allocator and the mirrored deque
+ * Author
+ *    Alexander Dohms, Stephen Costigan, Shaun Crook, Jonathan Colwell
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "deque.h"
+#include "mirrorAllocator.h"
+#include "unitTest.h"
+
+#include <cstring>
+#include <iostream>
+
+#ifdef DEQUE_MIRROR
+
+class TestMirrorAllocator : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Allocator
+      test_allocate_rounds();
+      test_allocate_mirrors();
+
+      // Deque
+      test_iaFromID_noFold();
+      test_contiguous_wrapped();
+      test_push_cycle();
+
+      report("MirrorAllocator");
+   }
+
+   typedef custom::deque<int, custom::capacity_mirror, custom::mirror_allocator<int>> Deque;
+
+   /***************************************
+    * ALLOCATOR
+    ***************************************/
+
+   // one element still takes a whole page
+   void test_allocate_rounds()
+   {  // setup
+      custom::mirror_allocator<int> alloc;
+      size_t numPage = (size_t)sysconf(_SC_PAGESIZE);
+      // exercise
+      auto result = alloc.allocate_at_least(1);
+      // verify
+      assertUnit(result.ptr != nullptr);
+      assertUnit(result.count == numPage / sizeof(int));
+      alloc.deallocate(result.ptr, result.count);
+   }  // teardown
+
+   // a write to one copy shows up in the other
+   void test_allocate_mirrors()
+   {  // setup
+      custom::mirror_allocator<int> alloc;
+      auto result = alloc.allocate_at_least(10);
+      int * p = result.ptr;
+      size_t n = result.count;
+      // exercise
+      p[0] = 11;
+      p[n + 1] = 26;
+      // verify
+      assertUnit(p[n] == 11);
+      assertUnit(p[1] == 26);
+      alloc.deallocate(p, n);
+   }  // teardown
+
+   /***************************************
+    * DEQUE
+    ***************************************/
+
+   // deque indexes run past the end of the array instead of folding
+   void test_iaFromID_noFold()
+   {  // setup
+      Deque d;
+      setupWrappedFixture(d);
+      // exercise
+      int ia0 = d.iaFromID(0);
+      int ia2 = d.iaFromID(2);
+      // verify
+      assertUnit(ia0 == (int)d.numCapacity - 1);
+      assertUnit(ia2 == (int)d.numCapacity + 1);
+      assertUnit(d[0] == 11);
+      assertUnit(d[1] == 26);
+      assertUnit(d[2] == 31);
+   }  // teardown
+
+   // a wrapped deque is still one run in memory
+   void test_contiguous_wrapped()
+   {  // setup
+      Deque d;
+      setupWrappedFixture(d);
+      int out[3] = { 0, 0, 0 };
+      // exercise
+      std::memcpy(out, d.contiguous(), d.size() * sizeof(int));
+      // verify
+      assertUnit(out[0] == 11);
+      assertUnit(out[1] == 26);
+      assertUnit(out[2] == 31);
+   }  // teardown
+
+   // the front goes round the array many times
+   void test_push_cycle()
+   {  // setup
+      Deque d;
+      d.push_back(0);
+      size_t numCapacity = d.numCapacity;
+      // exercise
+      for (int i = 1; i < (int)numCapacity * 3; i++)
+      {
+         d.push_back(i);
+         d.pop_front();
+      }
+      // verify
+      assertUnit(d.numCapacity == numCapacity);
+      assertUnit(d.size() == 1);
+      assertUnit(d.front() == (int)numCapacity * 3 - 1);
+   }  // teardown
+
+   // 11 in the last slot, then 26 and 31 at the start
+   void setupWrappedFixture(Deque & d)
+   {
+      d.push_back(0);
+      size_t numCapacity = d.numCapacity;
+      d.pop_back();
+      d.iaFront = (int)numCapacity - 1;
+      d.push_back(11);
+      d.push_back(26);
+      d.push_back(31);
+   }
+};
+
+#endif // DEQUE_MIRROR
+#endif // DEBUG
@@ -0,0 +1,169 @@
+/***********************************************************************
+ * Header:
+ *    TEST MMAP ALLOCATOR
+ * Summary:
+ *    Unit tests for the mmap allocator and growing a deque in place
+ * Author
+ *    Alexander Dohms, Stephen Costigan, Shaun Crook, Jonathan Colwell
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "deque.h"
+#include "mmapAllocator.h"
+#include "unitTest.h"
+
+#include <iostream>
+
+#ifdef DEQUE_MREMAP
+
+class TestMmapAllocator : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Allocator
+      test_reallocate_small();
+      test_reallocate_keeps();
+
+      // Deque
+      test_grow_unwrapped();
+      test_grow_movePrefix();
+      test_grow_moveFront();
+
+      report("MmapAllocator");
+   }
+
+   // every array is mapped, however small
+   typedef custom::mmap_allocator<int, 0> Mapped;
+   typedef custom::deque<int, custom::capacity_any, Mapped> Deque;
+
+   /***************************************
+    * ALLOCATOR
+    ***************************************/
+
+   // arrays under the threshold are left to the caller
+   void test_reallocate_small()
+   {  // setup
+      custom::mmap_allocator<int> alloc;
+      int * p = alloc.allocate(10);
+      // exercise
+      int * pNew = alloc.reallocate(p, 10, 20);
+      // verify
+      assertUnit(pNew == nullptr);
+      alloc.deallocate(p, 10);
+   }  // teardown
+
+   // a mapped array keeps its contents as it grows
+   void test_reallocate_keeps()
+   {  // setup
+      Mapped alloc;
+      size_t num = custom::mmap_allocator<int>::pageRound(1) / sizeof(int);
+      int * p = alloc.allocate(num);
+      for (size_t i = 0; i < num; i++)
+         p[i] = (int)i;
+      // exercise
+      int * pNew = alloc.reallocate(p, num, num * 4);
+      // verify
+      assertUnit(pNew != nullptr);
+      bool same = pNew != nullptr;
+      for (size_t i = 0; same && i < num; i++)
+         same = pNew[i] == (int)i;
+      assertUnit(same);
+      alloc.deallocate(pNew ? pNew : p, pNew ? num * 4 : num);
+   }  // teardown
+
+   /***************************************
+    * DEQUE
+    ***************************************/
+
+   // nothing wrapped, nothing moves
+   void test_grow_unwrapped()
+   {  // setup
+      //        iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    |    | 11 | 26 | 31 |
+      //    +----+----+----+----+
+      Deque d;
+      setupFixture(d, /*iaFront=*/1);
+      // exercise
+      d.resize(8);
+      // verify
+      assertUnit(d.numCapacity == 8);
+      assertUnit(d.iaFront == 1);
+      assertUnit(d.array[1] == 11);
+      assertUnit(d.array[3] == 31);
+      assertUnit(d.back() == 31);
+   }  // teardown
+
+   // a short wrapped prefix goes after the old end
+   void test_grow_movePrefix()
+   {  // setup
+      //             iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 31 |    | 11 | 26 |
+      //    +----+----+----+----+
+      Deque d;
+      setupFixture(d, /*iaFront=*/2);
+      // exercise
+      d.resize(8);
+      // verify
+      //             iaFront
+      // ia = 0    1    2    3    4    5    6    7
+      //    +----+----+----+----+----+----+----+----+
+      //    |    |    | 11 | 26 | 31 |    |    |    |
+      //    +----+----+----+----+----+----+----+----+
+      assertUnit(d.numCapacity == 8);
+      assertUnit(d.iaFront == 2);
+      assertUnit(d.array[4] == 31);
+      assertUnit(d[0] == 11);
+      assertUnit(d[2] == 31);
+   }  // teardown
+
+   // a short front run goes to the new end
+   void test_grow_moveFront()
+   {  // setup
+      //                       iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 |    | 11 |
+      //    +----+----+----+----+
+      Deque d;
+      setupFixture(d, /*iaFront=*/3);
+      // exercise
+      d.resize(8);
+      // verify
+      //                                       iaFront
+      // ia = 0    1    2    3    4    5    6    7
+      //    +----+----+----+----+----+----+----+----+
+      //    | 26 | 31 |    |    |    |    |    | 11 |
+      //    +----+----+----+----+----+----+----+----+
+      assertUnit(d.numCapacity == 8);
+      assertUnit(d.iaFront == 7);
+      assertUnit(d.array[7] == 11);
+      assertUnit(d[0] == 11);
+      assertUnit(d[1] == 26);
+      assertUnit(d[2] == 31);
+   }  // teardown
+
+   // 11, 26, 31 in a mapped array of four, starting at iaFront
+   void setupFixture(Deque & d, int iaFront)
+   {
+      d.array = d.allocate(4);
+      d.numCapacity = 4;
+      d.numElements = 3;
+      d.iaFront = iaFront;
+      d.array[iaFront]           = 11;
+      d.array[(iaFront + 1) % 4] = 26;
+      d.array[(iaFront + 2) % 4] = 31;
+   }
+};
+
+#endif // DEQUE_MREMAP
+#endif // DEBUG
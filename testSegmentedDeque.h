@@ -0,0 +1,383 @@
+/***********************************************************************
+ * Header:
+ *    TEST SEGMENTED DEQUE
+ * Summary:
+ *    Unit tests for the block-map storage engine of deque
+ * Author
+ *    Alexander Dohms, Stephen Costigan, Shaun Crook, Jonathan Colwell
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "deque.h"
+#include "unitTest.h"
+
+#include <string>
+#include <iostream>
+
+class TestSegmentedDeque : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Utilities
+      test_slot_standard();
+
+      // Construct
+      test_construct_default();
+      test_constructCopy_standard();
+      test_constructMove_standard();
+
+      // Access
+      test_subscriptRead_standard();
+
+      // Insert
+      test_pushback_empty();
+      test_pushback_newBlock();
+      test_pushfront_empty();
+      test_pushfront_newBlock();
+      test_push_growMap();
+      test_push_referencesStable();
+
+      // Remove
+      test_popback_releaseBlock();
+      test_popfront_releaseBlock();
+      test_clear_standard();
+
+      // Iterator
+      test_iterator_wide();
+
+      report("SegmentedDeque");
+   }
+
+   typedef custom::deque<int, custom::segmented<4>> Deque;
+
+   /***************************************
+    * UTILITIES
+    ***************************************/
+
+   // slot numbers are split into a block and an offset
+   void test_slot_standard()
+   {  // setup
+      Deque d;
+      setupStandardFixture(d);
+      // exercise
+      int & s0 = d.slot(/*s=*/6);
+      int & s2 = d.slot(/*s=*/8);
+      // verify
+      assertUnit(&s0 == d.map[1] + 2);
+      assertUnit(&s2 == d.map[2] + 0);
+      assertUnit(s0 == 11);
+      assertUnit(s2 == 31);
+   }  // teardown
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // default constructor, no allocations
+   void test_construct_default()
+   {  // setup
+      // exercise
+      Deque d;
+      // verify
+      assertUnit(d.map == nullptr);
+      assertUnit(d.numMap == 0);
+      assertUnit(d.numElements == 0);
+   }  // teardown
+
+   // copy constructor of the standard fixture
+   void test_constructCopy_standard()
+   {  // setup
+      Deque dSrc;
+      setupStandardFixture(dSrc);
+      // exercise
+      Deque dDes(dSrc);
+      // verify
+      assertStandardFixture(dSrc);
+      assertUnit(dDes.numElements == 3);
+      assertUnit(dDes.map != dSrc.map);
+      if (dDes.numElements == 3)
+      {
+         assertUnit(dDes[0] == 11);
+         assertUnit(dDes[1] == 26);
+         assertUnit(dDes[2] == 31);
+      }
+   }  // teardown
+
+   // move constructor takes the map
+   void test_constructMove_standard()
+   {  // setup
+      Deque dSrc;
+      setupStandardFixture(dSrc);
+      int ** map = dSrc.map;
+      // exercise
+      Deque dDes(std::move(dSrc));
+      // verify
+      assertUnit(dSrc.map == nullptr);
+      assertUnit(dSrc.numElements == 0);
+      assertUnit(dDes.map == map);
+      assertStandardFixture(dDes);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // read each element of the standard fixture
+   void test_subscriptRead_standard()
+   {  // setup
+      Deque d;
+      setupStandardFixture(d);
+      // exercise
+      int s0 = d[0];
+      int s1 = d[1];
+      int s2 = d[2];
+      // verify
+      assertUnit(s0 == 11);
+      assertUnit(s1 == 26);
+      assertUnit(s2 == 31);
+      assertUnit(d.front() == 11);
+      assertUnit(d.back() == 31);
+      assertStandardFixture(d);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push back to an empty deque allocates one block
+   void test_pushback_empty()
+   {  // setup
+      Deque d;
+      // exercise
+      d.push_back(99);
+      // verify
+      assertUnit(d.numElements == 1);
+      assertUnit(d.map != nullptr);
+      assertUnit(countBlocks(d) == 1);
+      if (d.numElements == 1)
+         assertUnit(d.front() == 99);
+   }  // teardown
+
+   // push back past the end of a block allocates the next block
+   void test_pushback_newBlock()
+   {  // setup
+      Deque d;
+      setupStandardFixture(d);
+      d.push_back(42);
+      d.push_back(43);
+      d.push_back(44);
+      // exercise
+      d.push_back(99);
+      // verify
+      //    map[1]                map[2]                map[3]
+      //    +---+---+----+----+   +----+----+----+----+ +----+---+---+---+
+      //    |   |   | 11 | 26 |   | 31 | 42 | 43 | 44 | | 99 |   |   |   |
+      //    +---+---+----+----+   +----+----+----+----+ +----+---+---+---+
+      assertUnit(d.numElements == 7);
+      assertUnit(d.iaFront == 6);
+      assertUnit(countBlocks(d) == 3);
+      assertUnit(d.map[3] != nullptr);
+      if (d.map[3] != nullptr)
+         assertUnit(d.map[3][0] == 99);
+   }  // teardown
+
+   // push front to an empty deque
+   void test_pushfront_empty()
+   {  // setup
+      Deque d;
+      // exercise
+      d.push_front(99);
+      // verify
+      assertUnit(d.numElements == 1);
+      assertUnit(countBlocks(d) == 1);
+      if (d.numElements == 1)
+         assertUnit(d.back() == 99);
+   }  // teardown
+
+   // push front past the beginning of a block allocates the previous block
+   void test_pushfront_newBlock()
+   {  // setup
+      Deque d;
+      setupStandardFixture(d);
+      d.push_front(42);
+      d.push_front(43);
+      // exercise
+      d.push_front(99);
+      // verify
+      //    map[0]                map[1]                map[2]
+      //    +---+---+---+----+    +----+----+----+----+ +----+---+---+---+
+      //    |   |   |   | 99 |    | 43 | 42 | 11 | 26 | | 31 |   |   |   |
+      //    +---+---+---+----+    +----+----+----+----+ +----+---+---+---+
+      assertUnit(d.numElements == 6);
+      assertUnit(d.iaFront == 3);
+      assertUnit(countBlocks(d) == 3);
+      if (d.numElements == 6)
+      {
+         assertUnit(d[0] == 99);
+         assertUnit(d[1] == 43);
+         assertUnit(d[3] == 11);
+         assertUnit(d[5] == 31);
+      }
+   }  // teardown
+
+   // push past both ends of the map many times
+   void test_push_growMap()
+   {  // setup
+      Deque d;
+      // exercise
+      for (int i = 0; i < 100; i++)
+      {
+         d.push_back(i);
+         d.push_front(-i);
+      }
+      // verify
+      assertUnit(d.numElements == 200);
+      assertUnit(d.numMap >= 50);
+      bool inOrder = true;
+      for (int i = 0; i < 100; i++)
+         inOrder = inOrder && d[99 - i] == -i && d[100 + i] == i;
+      assertUnit(inOrder);
+   }  // teardown
+
+   // no push at either end moves an element that is already there
+   void test_push_referencesStable()
+   {  // setup
+      custom::deque<std::string, custom::segmented<4>> d;
+      d.push_back("middle");
+      std::string * p = &d.front();
+      // exercise
+      for (int i = 0; i < 100; i++)
+      {
+         d.push_back("back");
+         d.push_front("front");
+      }
+      // verify
+      assertUnit(&d[100] == p);
+      assertUnit(*p == "middle");
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // popping the first element of a block releases the block
+   void test_popback_releaseBlock()
+   {  // setup
+      Deque d;
+      setupStandardFixture(d);
+      // exercise
+      d.pop_back();
+      // verify
+      //    map[1]
+      //    +---+---+----+----+
+      //    |   |   | 11 | 26 |
+      //    +---+---+----+----+
+      assertUnit(d.numElements == 2);
+      assertUnit(d.map[2] == nullptr);
+      assertUnit(countBlocks(d) == 1);
+   }  // teardown
+
+   // popping the last element of a block releases the block
+   void test_popfront_releaseBlock()
+   {  // setup
+      Deque d;
+      setupStandardFixture(d);
+      d.pop_front();
+      // exercise
+      d.pop_front();
+      // verify
+      //    map[2]
+      //    +----+---+---+---+
+      //    | 31 |   |   |   |
+      //    +----+---+---+---+
+      assertUnit(d.numElements == 1);
+      assertUnit(d.iaFront == 8);
+      assertUnit(d.map[1] == nullptr);
+      assertUnit(countBlocks(d) == 1);
+      if (d.numElements == 1)
+         assertUnit(d.front() == 31);
+   }  // teardown
+
+   // clear releases every block but keeps the map
+   void test_clear_standard()
+   {  // setup
+      Deque d;
+      setupStandardFixture(d);
+      // exercise
+      d.clear();
+      // verify
+      assertUnit(d.numElements == 0);
+      assertUnit(d.map != nullptr);
+      assertUnit(countBlocks(d) == 0);
+   }  // teardown
+
+   // ids and distances are as wide as size_t, past what an int holds
+   void test_iterator_wide()
+   {  // setup
+      Deque d;
+      size_t idFar = (size_t)std::numeric_limits<std::ptrdiff_t>::max() / 2 + 1;
+      Deque::iterator itFar(&d, idFar);
+      // exercise
+      std::ptrdiff_t distance = itFar - d.begin();
+      itFar += -(std::ptrdiff_t)idFar;
+      // verify
+      assertUnit(distance == (std::ptrdiff_t)idFar);
+      assertUnit(itFar == d.begin());
+   }  // teardown
+
+   /****************************************************************
+    * Setup Standard Fixture
+    *                map[1]              map[2]
+    *       +---+---+----+----+    +----+---+---+---+
+    *       |   |   | 11 | 26 |    | 31 |   |   |   |
+    *       +---+---+----+----+    +----+---+---+---+
+    *    s =  4   5   6    7         8
+    ****************************************************************/
+   void setupStandardFixture(Deque & d)
+   {
+      d.map = d.allocateMap(4);
+      d.numMap = 4;
+      d.map[1] = d.allocateBlock();
+      d.map[2] = d.allocateBlock();
+      d.map[1][2] = 11;
+      d.map[1][3] = 26;
+      d.map[2][0] = 31;
+      d.iaFront = 6;
+      d.numElements = 3;
+   }
+
+   /****************************************************************
+    * Verify Standard Fixture
+    ****************************************************************/
+   void assertStandardFixtureParameters(const Deque & d, int line, const char* function)
+   {
+      assertIndirect(d.numMap == 4);
+      assertIndirect(d.iaFront == 6);
+      assertIndirect(d.numElements == 3);
+      assertIndirect(d.map != nullptr);
+
+      if (d.numMap == 4 && d.map != nullptr && d.map[1] && d.map[2])
+      {
+         assertIndirect(d.map[1][2] == 11);
+         assertIndirect(d.map[1][3] == 26);
+         assertIndirect(d.map[2][0] == 31);
+      }
+   }
+
+   // number of blocks currently allocated
+   size_t countBlocks(const Deque & d)
+   {
+      size_t num = 0;
+      for (size_t i = 0; i < d.numMap; i++)
+         num += d.map[i] ? 1 : 0;
+      return num;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,294 @@
+/***********************************************************************
+ * Header:
+ *    TEST SMALL DEQUE
+ * Summary:
+ *    Unit tests for the inline-storage engine of deque
+ * Author
+ *    Alexander Dohms, Stephen Costigan, Shaun Crook, Jonathan Colwell
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "deque.h"
+#include "unitTest.h"
+
+#include <string>
+#include <iostream>
+#include <memory>
+#include <type_traits>
+
+/****************************************************************
+ * TAGGED ALLOCATOR
+ * std::allocator with a tag, so two of them can be unequal,
+ * that follows its deque on swap
+ ****************************************************************/
+template <class T>
+struct TaggedAllocator
+{
+   typedef T value_type;
+   typedef std::true_type propagate_on_container_swap;
+
+   TaggedAllocator(int tag = 0) : tag(tag) { }
+   template <class U>
+   TaggedAllocator(const TaggedAllocator<U> & rhs) : tag(rhs.tag) { }
+
+   T * allocate(size_t num)           { return std::allocator<T>().allocate(num);   }
+   void deallocate(T * p, size_t num) { std::allocator<T>().deallocate(p, num);     }
+
+   bool operator == (const TaggedAllocator & rhs) const { return tag == rhs.tag; }
+   bool operator != (const TaggedAllocator & rhs) const { return tag != rhs.tag; }
+
+   int tag;
+};
+
+class TestSmallDeque : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructMove_inline();
+      test_constructMove_spilled();
+      test_constructCopy_spilled();
+
+      // Insert
+      test_push_wrapInline();
+      test_push_spill();
+
+      // Remove
+      test_clear_staysSpilled();
+
+      // Status
+      test_shrinkToFit_backInline();
+      test_swap_inlineSpilled();
+      test_swap_propagates();
+
+      // Iterator
+      test_iterator_wide();
+
+      report("SmallDeque");
+   }
+
+   typedef custom::small_deque<int, 4> Deque;
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // a new deque already has its buffer
+   void test_construct_default()
+   {  // setup
+      // exercise
+      Deque d;
+      // verify
+      assertUnit(d.isInline());
+      assertUnit(d.numCapacity == 4);
+      assertUnit(d.numElements == 0);
+      assertUnit(d.iaFront == 0);
+   }  // teardown
+
+   // the elements of an inline deque move into the new buffer
+   void test_constructMove_inline()
+   {  // setup
+      custom::small_deque<std::string, 4> dSrc;
+      dSrc.push_back(std::string(100, 'a'));
+      dSrc.push_front(std::string(100, 'b'));
+      // exercise
+      custom::small_deque<std::string, 4> dDes(std::move(dSrc));
+      // verify
+      assertUnit(dSrc.isInline());
+      assertUnit(dSrc.numElements == 0);
+      assertUnit(dDes.isInline());
+      assertUnit(dDes.numElements == 2);
+      if (dDes.numElements == 2)
+      {
+         assertUnit(dDes[0] == std::string(100, 'b'));
+         assertUnit(dDes[1] == std::string(100, 'a'));
+      }
+   }  // teardown
+
+   // a spilled deque gives away its array
+   void test_constructMove_spilled()
+   {  // setup
+      Deque dSrc;
+      for (int i = 0; i < 6; i++)
+         dSrc.push_back(i);
+      int * data = dSrc.data;
+      // exercise
+      Deque dDes(std::move(dSrc));
+      // verify
+      assertUnit(dSrc.isInline());
+      assertUnit(dSrc.numElements == 0);
+      assertUnit(dDes.data == data);
+      assertUnit(dDes.numElements == 6);
+      assertUnit(dDes.back() == 5);
+   }  // teardown
+
+   // a copy is exactly as big as it needs to be
+   void test_constructCopy_spilled()
+   {  // setup
+      Deque dSrc;
+      for (int i = 0; i < 6; i++)
+         dSrc.push_front(i);
+      // exercise
+      Deque dDes(dSrc);
+      // verify
+      assertUnit(dSrc.numElements == 6);
+      assertUnit(dDes.numElements == 6);
+      assertUnit(dDes.numCapacity == 6);
+      assertUnit(dDes.front() == 5);
+      assertUnit(dDes.back() == 0);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // the ring wraps inside the buffer
+   void test_push_wrapInline()
+   {  // setup
+      Deque d;
+      d.push_back(26);
+      d.push_back(31);
+      // exercise
+      d.push_front(11);
+      // verify
+      //                       iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 |    | 11 |
+      //    +----+----+----+----+
+      assertUnit(d.isInline());
+      assertUnit(d.iaFront == 3);
+      assertUnit(d.data[3] == 11);
+      assertUnit(d[1] == 26);
+      assertUnit(d[2] == 31);
+   }  // teardown
+
+   // one past the buffer goes to the heap, unwrapped
+   void test_push_spill()
+   {  // setup
+      Deque d;
+      d.push_back(26);
+      d.push_back(31);
+      d.push_back(50);
+      d.push_front(11);
+      // exercise
+      d.push_back(99);
+      // verify
+      assertUnit(!d.isInline());
+      assertUnit(d.numCapacity == 8);
+      assertUnit(d.iaFront == 0);
+      assertUnit(d.data[0] == 11);
+      assertUnit(d.data[4] == 99);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // clear keeps the allocated array
+   void test_clear_staysSpilled()
+   {  // setup
+      Deque d;
+      for (int i = 0; i < 6; i++)
+         d.push_back(i);
+      // exercise
+      d.clear();
+      // verify
+      assertUnit(!d.isInline());
+      assertUnit(d.numElements == 0);
+      assertUnit(d.numCapacity == 8);
+   }  // teardown
+
+   /***************************************
+    * STATUS
+    ***************************************/
+
+   // a spilled deque that fits comes back to its buffer
+   void test_shrinkToFit_backInline()
+   {  // setup
+      Deque d;
+      for (int i = 0; i < 6; i++)
+         d.push_back(i);
+      d.pop_front();
+      d.pop_front();
+      d.pop_front();
+      // exercise
+      d.shrink_to_fit();
+      // verify
+      assertUnit(d.isInline());
+      assertUnit(d.numCapacity == 4);
+      assertUnit(d.numElements == 3);
+      assertUnit(d.front() == 3);
+      assertUnit(d.back() == 5);
+   }  // teardown
+
+   // swapping an inline deque moves its elements
+   void test_swap_inlineSpilled()
+   {  // setup
+      Deque d1;
+      d1.push_back(99);
+      Deque d2;
+      for (int i = 0; i < 6; i++)
+         d2.push_back(i);
+      int * data = d2.data;
+      // exercise
+      d1.swap(d2);
+      // verify
+      assertUnit(d1.data == data);
+      assertUnit(d1.numElements == 6);
+      assertUnit(d2.isInline());
+      assertUnit(d2.numElements == 1);
+      if (d2.numElements == 1)
+         assertUnit(d2.front() == 99);
+   }  // teardown
+
+   // the spilled array goes with its allocator, and nothing is allocated
+   void test_swap_propagates()
+   {  // setup
+      typedef custom::small_deque<int, 4, TaggedAllocator<int>> TaggedDeque;
+      TaggedDeque d1(TaggedAllocator<int>(1));
+      d1.push_back(99);
+      d1.push_front(11);
+      TaggedDeque d2(TaggedAllocator<int>(2));
+      for (int i = 0; i < 6; i++)
+         d2.push_back(i);
+      int * data = d2.data;
+      // exercise
+      d1.swap(d2);
+      // verify
+      assertUnit(d1.data == data);
+      assertUnit(d1.get_allocator().tag == 2);
+      assertUnit(d1.numElements == 6);
+      assertUnit(d2.isInline());
+      assertUnit(d2.get_allocator().tag == 1);
+      assertUnit(d2.numElements == 2);
+      if (d2.numElements == 2)
+      {
+         assertUnit(d2.front() == 11);
+         assertUnit(d2.back() == 99);
+      }
+   }  // teardown
+   // ids and distances are as wide as size_t, past what an int holds
+   void test_iterator_wide()
+   {  // setup
+      Deque d;
+      size_t idFar = (size_t)std::numeric_limits<std::ptrdiff_t>::max() / 2 + 1;
+      Deque::iterator itFar(&d, idFar);
+      // exercise
+      std::ptrdiff_t distance = itFar - d.begin();
+      itFar += -(std::ptrdiff_t)idFar;
+      // verify
+      assertUnit(distance == (std::ptrdiff_t)idFar);
+      assertUnit(itFar == d.begin());
+   }  // teardown
+
+};
+
+#endif // DEBUG
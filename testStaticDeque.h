@@ -0,0 +1,297 @@
+/***********************************************************************
+ * Header:
+ *    TEST STATIC DEQUE
+ * Summary:
+ *    Unit tests for the fixed-capacity engine of deque
+ * Author
+ *    Alexander Dohms, Stephen Costigan, Shaun Crook, Jonathan Colwell
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "deque.h"
+#include "unitTest.h"
+
+#include <string>
+#include <memory>
+#include <iostream>
+
+class TestStaticDeque : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Utilities
+      test_iaFromID_wrapped();
+      test_iaFromID_wrappedOdd();
+
+      // Construct
+      test_construct_default();
+      test_constructCopy_wrapped();
+      test_constructMove_wrapped();
+
+      // Insert
+      test_pushfront_wrap();
+      test_pushback_full();
+      test_tryPush_full();
+
+      // Remove
+      test_popfront_wrap();
+      test_clear_destroys();
+
+      // Status
+      test_swap_standardEmpty();
+
+      // Iterator
+      test_iterator_wide();
+
+      report("StaticDeque");
+   }
+
+   typedef custom::static_deque<int, 4> Deque;
+
+   /***************************************
+    * UTILITIES
+    ***************************************/
+
+   // a power-of-two capacity wraps with a mask
+   void test_iaFromID_wrapped()
+   {  // setup
+      //                  iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 |    | 11 |
+      //    +----+----+----+----+
+      // id = 1    2         0
+      Deque d;
+      setupWrappedFixture(d);
+      // exercise
+      size_t ia0 = d.iaFromID(/*id=*/0);
+      size_t ia1 = d.iaFromID(/*id=*/1);
+      size_t ia2 = d.iaFromID(/*id=*/2);
+      // verify
+      assertUnit(ia0 == 3);
+      assertUnit(ia1 == 0);
+      assertUnit(ia2 == 1);
+   }  // teardown
+
+   // any other capacity wraps with a compare
+   void test_iaFromID_wrappedOdd()
+   {  // setup
+      custom::static_deque<int, 3> d;
+      d.iaFront = 2;
+      // exercise
+      size_t ia0 = d.iaFromID(/*id=*/0);
+      size_t ia1 = d.iaFromID(/*id=*/1);
+      size_t ia2 = d.iaFromID(/*id=*/2);
+      // verify
+      assertUnit(ia0 == 2);
+      assertUnit(ia1 == 0);
+      assertUnit(ia2 == 1);
+   }  // teardown
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // a new deque is empty and already has all its room
+   void test_construct_default()
+   {  // setup
+      // exercise
+      Deque d;
+      // verify
+      assertUnit(d.numElements == 0);
+      assertUnit(d.iaFront == 0);
+      assertUnit(d.capacity() == 4);
+      assertUnit(sizeof(d) == 2 * sizeof(size_t) + 4 * sizeof(int));
+   }  // teardown
+
+   // a copy is unwrapped
+   void test_constructCopy_wrapped()
+   {  // setup
+      Deque dSrc;
+      setupWrappedFixture(dSrc);
+      // exercise
+      Deque dDes(dSrc);
+      // verify
+      assertWrappedFixture(dSrc);
+      assertUnit(dDes.numElements == 3);
+      assertUnit(dDes.iaFront == 0);
+      assertUnit(*dDes.slot(0) == 11);
+      assertUnit(*dDes.slot(1) == 26);
+      assertUnit(*dDes.slot(2) == 31);
+   }  // teardown
+
+   // a move leaves the source empty
+   void test_constructMove_wrapped()
+   {  // setup
+      Deque dSrc;
+      setupWrappedFixture(dSrc);
+      // exercise
+      Deque dDes(std::move(dSrc));
+      // verify
+      assertUnit(dSrc.numElements == 0);
+      assertUnit(dDes.numElements == 3);
+      assertUnit(dDes.front() == 11);
+      assertUnit(dDes.back() == 31);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push front off the start of the array lands at the end
+   void test_pushfront_wrap()
+   {  // setup
+      Deque d;
+      d.push_back(26);
+      d.push_back(31);
+      // exercise
+      d.push_front(11);
+      // verify
+      //                       iaFront
+      // ia = 0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 31 |    | 11 |
+      //    +----+----+----+----+
+      assertWrappedFixture(d);
+   }  // teardown
+
+   // the last slot fills without growing
+   void test_pushback_full()
+   {  // setup
+      Deque d;
+      setupWrappedFixture(d);
+      // exercise
+      d.push_back(50);
+      // verify
+      assertUnit(d.full());
+      assertUnit(d.numElements == 4);
+      assertUnit(d.iaFront == 3);
+      assertUnit(*d.slot(2) == 50);
+      assertUnit(d.back() == 50);
+   }  // teardown
+
+   // try_push on a full deque leaves it alone
+   void test_tryPush_full()
+   {  // setup
+      Deque d;
+      setupWrappedFixture(d);
+      // exercise
+      bool pushedBack   = d.try_push_back(50);
+      bool pushedFront  = d.try_push_front(99);
+      bool pushedAgain  = d.try_push_back(99);
+      // verify
+      assertUnit(pushedBack);
+      assertUnit(!pushedFront);
+      assertUnit(!pushedAgain);
+      assertUnit(d.numElements == 4);
+      assertUnit(d.front() == 11);
+      assertUnit(d.back() == 50);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // popping the last slot of the array wraps iaFront to 0
+   void test_popfront_wrap()
+   {  // setup
+      Deque d;
+      setupWrappedFixture(d);
+      // exercise
+      d.pop_front();
+      // verify
+      assertUnit(d.numElements == 2);
+      assertUnit(d.iaFront == 0);
+      assertUnit(d.front() == 26);
+      assertUnit(d.back() == 31);
+   }  // teardown
+
+   // clear runs the destructors
+   void test_clear_destroys()
+   {  // setup
+      std::shared_ptr<int> p = std::make_shared<int>(99);
+      custom::static_deque<std::shared_ptr<int>, 3> d;
+      d.push_back(p);
+      d.push_front(p);
+      // exercise
+      d.clear();
+      // verify
+      assertUnit(p.use_count() == 1);
+      assertUnit(d.numElements == 0);
+   }  // teardown
+
+   /***************************************
+    * STATUS
+    ***************************************/
+
+   // swap trades the elements themselves
+   void test_swap_standardEmpty()
+   {  // setup
+      custom::static_deque<std::string, 4> d1;
+      d1.push_back("twenty six");
+      d1.push_front("eleven");
+      custom::static_deque<std::string, 4> d2;
+      // exercise
+      d1.swap(d2);
+      // verify
+      assertUnit(d1.numElements == 0);
+      assertUnit(d2.numElements == 2);
+      if (d2.numElements == 2)
+      {
+         assertUnit(d2[0] == "eleven");
+         assertUnit(d2[1] == "twenty six");
+      }
+   }  // teardown
+
+   // ids and distances are as wide as size_t, past what an int holds
+   void test_iterator_wide()
+   {  // setup
+      Deque d;
+      size_t idFar = (size_t)std::numeric_limits<std::ptrdiff_t>::max() / 2 + 1;
+      Deque::iterator itFar(&d, idFar);
+      // exercise
+      std::ptrdiff_t distance = itFar - d.begin();
+      itFar += -(std::ptrdiff_t)idFar;
+      // verify
+      assertUnit(distance == (std::ptrdiff_t)idFar);
+      assertUnit(itFar == d.begin());
+   }  // teardown
+
+   /****************************************************************
+    * Setup Wrapped Fixture
+    *                  iaFront
+    * ia = 0    1    2    3
+    *    +----+----+----+----+
+    *    | 26 | 31 |    | 11 |
+    *    +----+----+----+----+
+    * id = 1    2         0
+    ****************************************************************/
+   void setupWrappedFixture(Deque & d)
+   {
+      *d.slot(0) = 26;
+      *d.slot(1) = 31;
+      *d.slot(3) = 11;
+      d.iaFront = 3;
+      d.numElements = 3;
+   }
+
+   /****************************************************************
+    * Verify Wrapped Fixture
+    ****************************************************************/
+   void assertWrappedFixtureParameters(const Deque & d, int line, const char* function)
+   {
+      assertIndirect(d.numElements == 3);
+      assertIndirect(d.iaFront == 3);
+      assertIndirect(*d.slot(0) == 26);
+      assertIndirect(*d.slot(1) == 31);
+      assertIndirect(*d.slot(3) == 11);
+   }
+};
+
+#endif // DEBUG
@@ -15,6 +15,8 @@
 #undef assertComplexFixture
 #undef assertStandardFixture
 #undef assertEmptyFixture
+#undef assertWrappedFixture
+#undef assertMigratingFixture
 
 
 #define assertUnit(condition)     assertUnitParameters(condition, #condition, __LINE__, __FUNCTION__)
@@ -22,6 +24,8 @@
 #define assertComplexFixture(x)   assertComplexFixtureParameters( x, __LINE__, __FUNCTION__)
 #define assertStandardFixture(x)  assertStandardFixtureParameters(x, __LINE__, __FUNCTION__)
 #define assertEmptyFixture(x)     assertEmptyFixtureParameters(   x, __LINE__, __FUNCTION__)
+#define assertWrappedFixture(x)   assertWrappedFixtureParameters( x, __LINE__, __FUNCTION__)
+#define assertMigratingFixture(x) assertMigratingFixtureParameters(x, __LINE__, __FUNCTION__)
 
 #include <iostream>  // for std::cerr
 #include <string>    // for std::string